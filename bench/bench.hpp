@@ -0,0 +1,307 @@
+/**
+ * @file bench.hpp
+ * @brief A tiny self contained micro benchmark harness modelled after Google Benchmark.
+ */
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <string>
+#include <vector>
+
+
+namespace reflex::bench
+{
+/**
+ * @brief Prevents the compiler from optimizing away the computation of value.
+ */
+template <typename T>
+inline auto do_not_optimize(const T& value) -> void
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+/**
+ * @brief Per run state handed to every benchmark. Iterate over it to run the timed loop.
+ */
+class state
+{
+public:
+    state(const size_t iterations, const int64_t arg) : m_iterations(iterations), m_arg(arg) { }
+
+    /// @brief What the timed loop yields, marked unused so for (auto _ : state) does not warn.
+    struct [[maybe_unused]] iteration
+    {
+    };
+
+    class iterator
+    {
+    public:
+        iterator(state* owner, const size_t remaining) : m_owner(owner), m_remaining(remaining) { }
+
+        auto operator*() const -> iteration { return { }; }
+        auto operator++() -> iterator& { --m_remaining; return *this; }
+
+        auto operator!=(const iterator&) -> bool
+        {
+            if (m_remaining) return true;
+            m_owner->stop();
+            return false;
+        }
+
+    private:
+        state* m_owner;
+        size_t m_remaining;
+    };
+
+    auto begin() -> iterator
+    {
+        m_elapsed = { };
+        m_start   = clock::now();
+        return iterator{ this, m_iterations };
+    }
+
+    auto end() -> iterator { return iterator{ this, 0 }; }
+
+    /// @brief Stops the clock, for per iteration setup which should not be measured.
+    auto pause_timing() -> void { m_elapsed += clock::now() - m_start; }
+    /// @brief Restarts the clock after pause_timing().
+    auto resume_timing() -> void { m_start = clock::now(); }
+
+    /**
+     * @brief Times fn as the entire run instead of iterating, for benchmarks which spread iterations()
+     * over several threads themselves.
+     */
+    template <typename Fn>
+    auto measure(Fn&& fn) -> void
+    {
+        m_elapsed = { };
+        m_start   = clock::now();
+        fn();
+        stop();
+    }
+
+    /// @brief The argument this run was registered with.
+    [[nodiscard]] auto arg() const noexcept -> int64_t { return m_arg; }
+    [[nodiscard]] auto iterations() const noexcept -> size_t { return m_iterations; }
+    [[nodiscard]] auto elapsed() const noexcept -> std::chrono::nanoseconds { return m_elapsed; }
+
+    /// @brief The number of logical items handled in the whole run, used to report items per second.
+    auto set_items_processed(const uint64_t items) noexcept -> void { m_items = items; }
+    /// @brief The number of bytes handled in the whole run, used to report throughput.
+    auto set_bytes_processed(const uint64_t bytes) noexcept -> void { m_bytes = bytes; }
+
+    [[nodiscard]] auto items_processed() const noexcept -> uint64_t { return m_items; }
+    [[nodiscard]] auto bytes_processed() const noexcept -> uint64_t { return m_bytes; }
+
+private:
+    using clock = std::chrono::steady_clock;
+
+    auto stop() -> void { m_elapsed += clock::now() - m_start; }
+
+    size_t m_iterations;
+    int64_t m_arg;
+    clock::time_point m_start{ };
+    std::chrono::nanoseconds m_elapsed{ };
+    uint64_t m_items = 0;
+    uint64_t m_bytes = 0;
+};
+
+using benchmark_fn = void (*)(state&);
+
+struct benchmark
+{
+    std::string name;
+    benchmark_fn fn;
+    std::vector<int64_t> args;
+};
+
+inline auto registry() -> std::vector<benchmark>&
+{
+    static std::vector<benchmark> benchmarks;
+    return benchmarks;
+}
+
+struct registrar
+{
+    registrar(const char* name, const benchmark_fn fn, std::vector<int64_t> args)
+    {
+        if (args.empty()) args.push_back(0);
+        registry().push_back(benchmark{ name, fn, std::move(args) });
+    }
+};
+
+/**
+ * @brief Runs fn with a growing iteration count until a run takes at least min_time.
+ */
+inline auto calibrate(const benchmark_fn fn, const int64_t arg, const std::chrono::nanoseconds min_time) -> state
+{
+    for (size_t iterations = 1;; iterations *= 10) {
+        state s{ iterations, arg };
+        fn(s);
+        if (s.elapsed() >= min_time || iterations >= 1'000'000'000) return s;
+        // jump close to the target once we have a meaningful measurement, fixed per run costs such as
+        // starting threads must not dominate the estimate
+        if (s.elapsed() > min_time / 10) {
+            const auto scaled = static_cast<size_t>(iterations * 1.4 * min_time.count() / s.elapsed().count());
+            state final_run{ scaled, arg };
+            fn(final_run);
+            return final_run;
+        }
+    }
+}
+
+/// @brief The measurement of a single benchmark and argument pair.
+struct result
+{
+    std::string name;
+    int64_t arg;
+    size_t iterations;
+    double ns_per_iteration;
+    double items_per_second;
+    double bytes_per_second;
+};
+
+/// @brief Command line options of the benchmark binary.
+struct options
+{
+    std::string filter;
+    std::string json_path;
+    std::chrono::milliseconds min_time{ 200 };
+};
+
+/**
+ * @brief Parses [filter] [--filter=substring] [--json=path] [--min_time_ms=n].
+ */
+inline auto parse_options(const int argc, char** argv) -> options
+{
+    options opts;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg.starts_with("--json=")) {
+            opts.json_path = arg.substr(7);
+        } else if (arg.starts_with("--filter=")) {
+            opts.filter = arg.substr(9);
+        } else if (arg.starts_with("--min_time_ms=")) {
+            opts.min_time = std::chrono::milliseconds{ std::stoll(arg.substr(14)) };
+        } else {
+            opts.filter = arg;
+        }
+    }
+    return opts;
+}
+
+inline auto escape_json(const std::string& str) -> std::string
+{
+    std::string escaped;
+    for (const char c : str) {
+        if (c == '"' || c == '\\') escaped += '\\';
+        escaped += c;
+    }
+    return escaped;
+}
+
+/**
+ * @brief Writes results in a Google Benchmark compatible JSON layout so existing tooling can track them.
+ */
+inline auto write_json(std::FILE* out, const std::vector<result>& results) -> void
+{
+    const auto now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    char date[32];
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+#ifdef NDEBUG
+    const char* build_type = "release";
+#else
+    const char* build_type = "debug";
+#endif
+#if defined(__VERSION__)
+    const char* compiler = __VERSION__;
+#else
+    const char* compiler = "unknown";
+#endif
+
+    std::fprintf(out, "{\n  \"context\": {\n");
+    std::fprintf(out, "    \"date\": \"%s\",\n", date);
+    std::fprintf(out, "    \"library\": \"reflex\",\n");
+    std::fprintf(out, "    \"compiler\": \"%s\",\n", escape_json(compiler).c_str());
+    std::fprintf(out, "    \"library_build_type\": \"%s\"\n  },\n", build_type);
+    std::fprintf(out, "  \"benchmarks\": [");
+    for (size_t i = 0; i < results.size(); ++i) {
+        const result& r = results[i];
+        std::fprintf(out, "%s\n    {\n", i ? "," : "");
+        std::fprintf(out, "      \"name\": \"%s\",\n", escape_json(r.name).c_str());
+        std::fprintf(out, "      \"arg\": %lld,\n", static_cast<long long>(r.arg));
+        std::fprintf(out, "      \"iterations\": %zu,\n", r.iterations);
+        std::fprintf(out, "      \"real_time\": %.4f,\n", r.ns_per_iteration);
+        std::fprintf(out, "      \"time_unit\": \"ns\",\n");
+        std::fprintf(out, "      \"items_per_second\": %.4f,\n", r.items_per_second);
+        std::fprintf(out, "      \"bytes_per_second\": %.4f\n    }", r.bytes_per_second);
+    }
+    std::fprintf(out, "\n  ]\n}\n");
+}
+
+/**
+ * @brief Runs every registered benchmark matching the filter, printing a table and optionally JSON.
+ */
+inline auto run_all(const int argc, char** argv) -> int
+{
+    const options opts = parse_options(argc, argv);
+
+    std::vector<result> results;
+    std::printf("%-48s %14s %14s %16s\n", "benchmark", "iterations", "ns/iter", "throughput");
+    for (const auto& [name, fn, args] : registry()) {
+        for (const int64_t arg : args) {
+            const std::string label = args.size() > 1 ? name + "/" + std::to_string(arg) : name;
+            if (label.find(opts.filter) == std::string::npos) continue;
+
+            const state s = calibrate(fn, arg, opts.min_time);
+
+            const double ns      = static_cast<double>(s.elapsed().count());
+            const double seconds = ns / 1e9;
+            const result r{
+                label,
+                arg,
+                s.iterations(),
+                ns / s.iterations(),
+                s.items_processed() / seconds,
+                s.bytes_processed() / seconds,
+            };
+            results.push_back(r);
+
+            char throughput[32] = "";
+            if (r.bytes_per_second > 0) {
+                std::snprintf(throughput, sizeof(throughput), "%.1f MB/s", r.bytes_per_second / 1e6);
+            } else if (r.items_per_second > 0) {
+                std::snprintf(throughput, sizeof(throughput), "%.1f M/s", r.items_per_second / 1e6);
+            }
+            std::printf("%-48s %14zu %14.2f %16s\n", label.c_str(), r.iterations, r.ns_per_iteration, throughput);
+            std::fflush(stdout);
+        }
+    }
+
+    if (!opts.json_path.empty()) {
+        std::FILE* out = std::fopen(opts.json_path.c_str(), "w");
+        if (!out) {
+            std::fprintf(stderr, "failed to open %s\n", opts.json_path.c_str());
+            return 1;
+        }
+        write_json(out, results);
+        std::fclose(out);
+    }
+    return 0;
+}
+} // namespace reflex::bench
+
+/**
+ * @brief Registers a benchmark function, optionally once per argument.
+ */
+#define REFLEX_BENCHMARK(fn, ...) \
+    static const ::reflex::bench::registrar fn##_registrar{ #fn, fn, { __VA_ARGS__ } }
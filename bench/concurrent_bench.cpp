@@ -0,0 +1,141 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <latch>
+#include <random>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "bench.hpp"
+#include "reflex.hpp"
+
+namespace
+{
+constexpr size_t type_count = 4096;
+
+/// @brief Names shared by every run, hashed_string only references them.
+auto names() -> const std::vector<std::string>&
+{
+    static const std::vector<std::string> result = [] {
+        std::vector<std::string> generated;
+        for (size_t i = 0; i < type_count * 2; ++i) generated.push_back("concurrent_type_" + std::to_string(i));
+        return generated;
+    }();
+    return result;
+}
+
+/// @brief Fills ctx with the first type_count names.
+auto fill(reflex::context& ctx) -> void
+{
+    for (size_t i = 0; i < type_count; ++i) {
+        const reflex::hashed_string hash{ names()[i].c_str() };
+        ctx.emplace(hash, reflex::internal::type_descriptor{ { }, 16, { } });
+    }
+}
+
+/// @brief Each thread probes the captured names in its own random order.
+auto probe_order(const size_t seed) -> std::vector<reflex::hashed_string>
+{
+    std::vector<reflex::hashed_string> order;
+    for (size_t i = 0; i < type_count; ++i) order.emplace_back(names()[i].c_str());
+    std::shuffle(order.begin(), order.end(), std::mt19937_64{ seed });
+    return order;
+}
+
+/**
+ * @brief Runs state.iterations() probes on each of state.arg() threads, timing from release to the last join.
+ * @param writer If given, called with a growing counter on another thread for as long as the readers run.
+ */
+template <typename Probe, typename Writer = std::nullptr_t>
+auto run_lookups(reflex::bench::state& state, const Probe& probe, const Writer& writer = nullptr) -> void
+{
+    const auto threads = static_cast<size_t>(state.arg());
+
+    std::vector<std::vector<reflex::hashed_string>> orders;
+    for (size_t t = 0; t < threads; ++t) orders.push_back(probe_order(t));
+
+    std::latch start{ 1 };
+    std::atomic<bool> done{ false };
+    std::vector<std::thread> pool;
+    for (size_t t = 0; t < threads; ++t) {
+        pool.emplace_back([&, t] {
+            const auto& order = orders[t];
+            start.wait();
+            for (size_t i = 0, j = 0; i < state.iterations(); ++i) {
+                reflex::bench::do_not_optimize(probe(order[j]));
+                if (++j == order.size()) j = 0;
+            }
+        });
+    }
+
+    std::thread background;
+    if constexpr (!std::is_null_pointer_v<Writer>) {
+        background = std::thread{ [&] {
+            start.wait();
+            for (size_t i = 0; !done.load(std::memory_order_relaxed); ++i) writer(i);
+        } };
+    }
+
+    state.measure([&] {
+        start.count_down();
+        for (auto& thread : pool) thread.join();
+    });
+    done.store(true, std::memory_order_relaxed);
+    if (background.joinable()) background.join();
+
+    state.set_items_processed(state.iterations() * threads);
+}
+
+auto concurrent_lookup(reflex::bench::state& state) -> void
+{
+    static reflex::context ctx;
+    if (ctx.empty()) fill(ctx);
+    run_lookups(state, [&](const reflex::hashed_string& hash) { return ctx.find(hash); });
+}
+
+auto concurrent_lookup_frozen(reflex::bench::state& state) -> void
+{
+    static const reflex::context& ctx = []() -> const reflex::context& {
+        static reflex::context c;
+        fill(c);
+        c.freeze();
+        return c;
+    }();
+    run_lookups(state, [&](const reflex::hashed_string& hash) { return ctx.find(hash); });
+}
+
+auto concurrent_lookup_while_capturing(reflex::bench::state& state) -> void
+{
+    reflex::context ctx;
+    fill(ctx);
+    run_lookups(
+            state,
+            [&](const reflex::hashed_string& hash) { return ctx.find(hash); },
+            [&](const size_t i) {
+                const reflex::hashed_string hash{ names()[type_count + i % type_count].c_str() };
+                ctx.emplace(hash, reflex::internal::type_descriptor{ { }, 16, { } });
+                std::this_thread::yield();
+            });
+}
+
+/// @brief Every probe pins the current version, while another thread hot reloads the types every millisecond.
+auto concurrent_snapshot_lookup_while_reloading(reflex::bench::state& state) -> void
+{
+    static reflex::versioned_context types;
+    if (types.version() == 1) types.define(reflex::hashed_string{ "filler" }, fill);
+    run_lookups(
+            state,
+            [&](const reflex::hashed_string& hash) { return types.pin()->contains(hash); },
+            [&](size_t) {
+                types.define(reflex::hashed_string{ "filler" }, fill);
+                std::this_thread::sleep_for(std::chrono::milliseconds{ 1 });
+            });
+}
+} // namespace
+
+REFLEX_BENCHMARK(concurrent_lookup, 1, 2, 4, 8, 16, 32, 64);
+REFLEX_BENCHMARK(concurrent_lookup_frozen, 1, 2, 4, 8, 16, 32, 64);
+REFLEX_BENCHMARK(concurrent_lookup_while_capturing, 1, 2, 4, 8, 16, 32, 64);
+REFLEX_BENCHMARK(concurrent_snapshot_lookup_while_reloading, 1, 2, 4, 8, 16, 32, 64);
@@ -0,0 +1,127 @@
+#include <algorithm>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include "bench.hpp"
+#include "reflex.hpp"
+
+namespace
+{
+using baseline_map = std::unordered_map<reflex::hashed_string, reflex::internal::type_descriptor>;
+
+/// @brief Keeps generated names alive, hashed_string only references them.
+struct key_set
+{
+    explicit key_set(const size_t count, const char* prefix)
+    {
+        names.reserve(count);
+        for (size_t i = 0; i < count; ++i) names.push_back(prefix + std::to_string(i));
+        for (const auto& name : names) keys.emplace_back(name.c_str());
+    }
+
+    /// @brief Returns the keys in a random order so lookups do not walk memory linearly.
+    auto shuffled() const -> std::vector<reflex::hashed_string>
+    {
+        auto result = keys;
+        std::shuffle(result.begin(), result.end(), std::mt19937_64{ 42 });
+        return result;
+    }
+
+    std::vector<std::string> names;
+    std::vector<reflex::hashed_string> keys;
+};
+
+auto descriptor() -> reflex::internal::type_descriptor
+{
+    return reflex::internal::type_descriptor{ { }, 16, { } };
+}
+
+template <typename Map>
+auto fill(Map& map, const key_set& keys) -> void
+{
+    for (const auto& key : keys.keys) map.emplace(key, descriptor());
+}
+
+/// @brief A context which is frozen right after being filled.
+struct frozen_context : reflex::context { };
+
+auto fill(frozen_context& ctx, const key_set& keys) -> void
+{
+    fill<reflex::context>(ctx, keys);
+    ctx.freeze();
+}
+
+template <typename Map>
+auto probe(const Map& map, const reflex::hashed_string& key) -> const void*
+{
+    if constexpr (std::is_same_v<Map, baseline_map>) {
+        const auto it = map.find(key);
+        return it == map.end() ? nullptr : &it->second;
+    } else {
+        return map.find(key);
+    }
+}
+
+template <typename Map>
+auto bench_hit(reflex::bench::state& state) -> void
+{
+    const key_set keys{ static_cast<size_t>(state.arg()), "type_" };
+    Map map;
+    fill(map, keys);
+    const auto order = keys.shuffled();
+
+    size_t i = 0;
+    for (auto _ : state) {
+        reflex::bench::do_not_optimize(probe(map, order[i]));
+        if (++i == order.size()) i = 0;
+    }
+    state.set_items_processed(state.iterations());
+}
+
+template <typename Map>
+auto bench_miss(reflex::bench::state& state) -> void
+{
+    const key_set keys{ static_cast<size_t>(state.arg()), "type_" };
+    const key_set missing{ static_cast<size_t>(state.arg()), "missing_" };
+    Map map;
+    fill(map, keys);
+    const auto order = missing.shuffled();
+
+    size_t i = 0;
+    for (auto _ : state) {
+        reflex::bench::do_not_optimize(probe(map, order[i]));
+        if (++i == order.size()) i = 0;
+    }
+    state.set_items_processed(state.iterations());
+}
+
+template <typename Map>
+auto bench_insert(reflex::bench::state& state) -> void
+{
+    const key_set keys{ static_cast<size_t>(state.arg()), "type_" };
+    for (auto _ : state) {
+        Map map;
+        fill(map, keys);
+        reflex::bench::do_not_optimize(map.size());
+    }
+    state.set_items_processed(state.iterations() * keys.keys.size());
+}
+
+auto context_hit(reflex::bench::state& state) -> void { bench_hit<reflex::context>(state); }
+auto unordered_map_hit(reflex::bench::state& state) -> void { bench_hit<baseline_map>(state); }
+auto context_miss(reflex::bench::state& state) -> void { bench_miss<reflex::context>(state); }
+auto unordered_map_miss(reflex::bench::state& state) -> void { bench_miss<baseline_map>(state); }
+auto frozen_context_hit(reflex::bench::state& state) -> void { bench_hit<frozen_context>(state); }
+auto frozen_context_miss(reflex::bench::state& state) -> void { bench_miss<frozen_context>(state); }
+auto context_insert(reflex::bench::state& state) -> void { bench_insert<reflex::context>(state); }
+auto unordered_map_insert(reflex::bench::state& state) -> void { bench_insert<baseline_map>(state); }
+} // namespace
+
+REFLEX_BENCHMARK(context_hit, 64, 4096, 100000);
+REFLEX_BENCHMARK(unordered_map_hit, 64, 4096, 100000);
+REFLEX_BENCHMARK(context_miss, 64, 4096, 100000);
+REFLEX_BENCHMARK(unordered_map_miss, 64, 4096, 100000);
+REFLEX_BENCHMARK(frozen_context_hit, 64, 4096, 100000);
+REFLEX_BENCHMARK(frozen_context_miss, 64, 4096, 100000);
+REFLEX_BENCHMARK(context_insert, 64, 4096, 100000);
+REFLEX_BENCHMARK(unordered_map_insert, 64, 4096, 100000);
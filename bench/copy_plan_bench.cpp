@@ -0,0 +1,89 @@
+#include <cstring>
+#include <vector>
+#include "bench.hpp"
+#include "reflex.hpp"
+
+namespace
+{
+struct component { };
+
+struct pos_component : component
+{
+    float x, y, z;
+};
+
+struct transform_component : component
+{
+    float x, y, z;
+    bool dirty;
+    double rotation;
+    uint16_t layer;
+};
+
+auto copy_context() -> const reflex::context&
+{
+    static const reflex::context& ctx = []() -> const reflex::context& {
+        static reflex::context c;
+        reflex::capture<pos_component>(c, "pos_component")
+                .field<&pos_component::x>("x")
+                .field<&pos_component::y>("y")
+                .field<&pos_component::z>("z");
+        reflex::capture<transform_component>(c, "transform_component")
+                .field<&transform_component::x>("x")
+                .field<&transform_component::y>("y")
+                .field<&transform_component::z>("z")
+                .field<&transform_component::dirty>("dirty")
+                .field<&transform_component::rotation>("rotation")
+                .field<&transform_component::layer>("layer");
+        return c;
+    }();
+    return ctx;
+}
+
+constexpr size_t object_count = 4096;
+
+template <typename T>
+auto bench_per_field(reflex::bench::state& state) -> void
+{
+    const auto type = reflex::lookup<T>(copy_context());
+    const std::vector<T> src(object_count);
+    std::vector<T> dst(object_count);
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < object_count; ++i) {
+            for (const auto& field : type.fields()) {
+                std::memcpy(
+                        reinterpret_cast<std::byte*>(&dst[i]) + field.offset(),
+                        reinterpret_cast<const std::byte*>(&src[i]) + field.offset(),
+                        field.size());
+            }
+        }
+        reflex::bench::do_not_optimize(dst.data());
+    }
+    state.set_items_processed(state.iterations() * object_count);
+}
+
+template <typename T>
+auto bench_plan(reflex::bench::state& state) -> void
+{
+    const auto& plan = reflex::lookup<T>(copy_context()).copy_plan();
+    const std::vector<T> src(object_count);
+    std::vector<T> dst(object_count);
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < object_count; ++i) plan.copy(&dst[i], &src[i]);
+        reflex::bench::do_not_optimize(dst.data());
+    }
+    state.set_items_processed(state.iterations() * object_count);
+}
+
+auto pos_copy_per_field(reflex::bench::state& state) -> void { bench_per_field<pos_component>(state); }
+auto pos_copy_plan(reflex::bench::state& state) -> void { bench_plan<pos_component>(state); }
+auto transform_copy_per_field(reflex::bench::state& state) -> void { bench_per_field<transform_component>(state); }
+auto transform_copy_plan(reflex::bench::state& state) -> void { bench_plan<transform_component>(state); }
+} // namespace
+
+REFLEX_BENCHMARK(pos_copy_per_field);
+REFLEX_BENCHMARK(pos_copy_plan);
+REFLEX_BENCHMARK(transform_copy_per_field);
+REFLEX_BENCHMARK(transform_copy_plan);
@@ -0,0 +1,234 @@
+#include <random>
+#include <span>
+#include <string_view>
+#include <vector>
+#include "bench.hpp"
+#include "reflex.hpp"
+
+namespace
+{
+enum class log_level
+{
+    trace,
+    debug,
+    info,
+    notice,
+    warning,
+    error,
+    critical,
+    alert,
+    emergency,
+    fatal,
+    off,
+};
+
+constexpr std::string_view level_names[] = {
+    "trace", "debug", "info", "notice", "warning", "error", "critical", "alert", "emergency", "fatal", "off",
+};
+
+enum class palette
+{
+    black,
+    white,
+    red,
+    green,
+    blue,
+    yellow,
+    cyan,
+    magenta,
+    orange,
+    purple,
+    pink,
+    brown,
+    gray,
+    silver,
+    gold,
+    navy,
+    teal,
+    olive,
+    maroon,
+    lime,
+    aqua,
+    coral,
+    salmon,
+    khaki,
+    indigo,
+    violet,
+    beige,
+    ivory,
+    lavender,
+    crimson,
+    turquoise,
+    chocolate,
+};
+
+constexpr std::string_view palette_names[] = {
+    "black", "white", "red", "green", "blue", "yellow", "cyan", "magenta", "orange", "purple", "pink", "brown",
+    "gray", "silver", "gold", "navy", "teal", "olive", "maroon", "lime", "aqua", "coral", "salmon", "khaki",
+    "indigo", "violet", "beige", "ivory", "lavender", "crimson", "turquoise", "chocolate",
+};
+
+auto captured() -> const reflex::context&
+{
+    static reflex::context ctx;
+    static const bool done = [] {
+        using enum log_level;
+        reflex::capture_enum<log_level>(ctx, "log_level")
+                .values<trace, debug, info, notice, warning, error, critical, alert, emergency, fatal, off>();
+        using enum palette;
+        reflex::capture_enum<palette>(ctx, "palette")
+                .values<black, white, red, green, blue, yellow, cyan, magenta, orange, purple, pink, brown, gray,
+                        silver, gold, navy, teal, olive, maroon, lime, aqua, coral, salmon, khaki, indigo, violet,
+                        beige, ivory, lavender, crimson, turquoise, chocolate>();
+        return true;
+    }();
+    (void)done;
+    return ctx;
+}
+
+/// @brief The hand written conversion found in most config parsers, one string compare per enumerator.
+auto parse_by_if_chain(const std::string_view name) -> log_level
+{
+    if (name == "trace") return log_level::trace;
+    if (name == "debug") return log_level::debug;
+    if (name == "info") return log_level::info;
+    if (name == "notice") return log_level::notice;
+    if (name == "warning") return log_level::warning;
+    if (name == "error") return log_level::error;
+    if (name == "critical") return log_level::critical;
+    if (name == "alert") return log_level::alert;
+    if (name == "emergency") return log_level::emergency;
+    if (name == "fatal") return log_level::fatal;
+    return log_level::off;
+}
+
+auto parse_palette_by_if_chain(const std::string_view name) -> palette
+{
+    if (name == "black") return palette::black;
+    if (name == "white") return palette::white;
+    if (name == "red") return palette::red;
+    if (name == "green") return palette::green;
+    if (name == "blue") return palette::blue;
+    if (name == "yellow") return palette::yellow;
+    if (name == "cyan") return palette::cyan;
+    if (name == "magenta") return palette::magenta;
+    if (name == "orange") return palette::orange;
+    if (name == "purple") return palette::purple;
+    if (name == "pink") return palette::pink;
+    if (name == "brown") return palette::brown;
+    if (name == "gray") return palette::gray;
+    if (name == "silver") return palette::silver;
+    if (name == "gold") return palette::gold;
+    if (name == "navy") return palette::navy;
+    if (name == "teal") return palette::teal;
+    if (name == "olive") return palette::olive;
+    if (name == "maroon") return palette::maroon;
+    if (name == "lime") return palette::lime;
+    if (name == "aqua") return palette::aqua;
+    if (name == "coral") return palette::coral;
+    if (name == "salmon") return palette::salmon;
+    if (name == "khaki") return palette::khaki;
+    if (name == "indigo") return palette::indigo;
+    if (name == "violet") return palette::violet;
+    if (name == "beige") return palette::beige;
+    if (name == "ivory") return palette::ivory;
+    if (name == "lavender") return palette::lavender;
+    if (name == "crimson") return palette::crimson;
+    if (name == "turquoise") return palette::turquoise;
+    return palette::chocolate;
+}
+
+auto name_by_switch(const log_level level) -> const char*
+{
+    switch (level) {
+        case log_level::trace: return "trace";
+        case log_level::debug: return "debug";
+        case log_level::info: return "info";
+        case log_level::notice: return "notice";
+        case log_level::warning: return "warning";
+        case log_level::error: return "error";
+        case log_level::critical: return "critical";
+        case log_level::alert: return "alert";
+        case log_level::emergency: return "emergency";
+        case log_level::fatal: return "fatal";
+        case log_level::off: return "off";
+    }
+    return nullptr;
+}
+
+constexpr size_t probes = 1024;
+
+/// @brief Converts names drawn in a random order, so branch prediction can not learn the if-chain.
+template <typename Parse>
+auto run_parses(reflex::bench::state& state, const std::span<const std::string_view> names, const Parse& parse) -> void
+{
+    std::mt19937_64 rng{ names.size() };
+    std::vector<std::string_view> order;
+    for (size_t i = 0; i < probes; ++i) order.push_back(names[rng() % names.size()]);
+
+    for (auto _ : state) {
+        for (const std::string_view name : order) reflex::bench::do_not_optimize(parse(name));
+    }
+    state.set_items_processed(state.iterations() * probes);
+}
+
+auto log_level_from_string_if_chain(reflex::bench::state& state) -> void
+{
+    run_parses(state, level_names, parse_by_if_chain);
+}
+
+auto log_level_from_string_reflex(reflex::bench::state& state) -> void
+{
+    const reflex::context& ctx = captured();
+    run_parses(state, level_names, [&](const std::string_view name) {
+        return reflex::enum_value<log_level>(ctx, name);
+    });
+}
+
+auto palette_from_string_if_chain(reflex::bench::state& state) -> void
+{
+    run_parses(state, palette_names, parse_palette_by_if_chain);
+}
+
+auto palette_from_string_reflex(reflex::bench::state& state) -> void
+{
+    const reflex::context& ctx = captured();
+    run_parses(state, palette_names, [&](const std::string_view name) {
+        return reflex::enum_value<palette>(ctx, name);
+    });
+}
+
+auto random_levels() -> std::vector<log_level>
+{
+    std::mt19937_64 rng{ probes };
+    std::vector<log_level> levels;
+    for (size_t i = 0; i < probes; ++i) levels.push_back(static_cast<log_level>(rng() % std::size(level_names)));
+    return levels;
+}
+
+auto log_level_to_string_switch(reflex::bench::state& state) -> void
+{
+    const std::vector<log_level> levels = random_levels();
+    for (auto _ : state) {
+        for (const log_level level : levels) reflex::bench::do_not_optimize(name_by_switch(level));
+    }
+    state.set_items_processed(state.iterations() * probes);
+}
+
+auto log_level_to_string_reflex(reflex::bench::state& state) -> void
+{
+    const reflex::context& ctx          = captured();
+    const std::vector<log_level> levels = random_levels();
+    for (auto _ : state) {
+        for (const log_level level : levels) reflex::bench::do_not_optimize(reflex::enum_name(ctx, level));
+    }
+    state.set_items_processed(state.iterations() * probes);
+}
+} // namespace
+
+REFLEX_BENCHMARK(log_level_from_string_if_chain);
+REFLEX_BENCHMARK(log_level_from_string_reflex);
+REFLEX_BENCHMARK(palette_from_string_if_chain);
+REFLEX_BENCHMARK(palette_from_string_reflex);
+REFLEX_BENCHMARK(log_level_to_string_switch);
+REFLEX_BENCHMARK(log_level_to_string_reflex);
@@ -0,0 +1,79 @@
+#include <memory>
+#include <string>
+#include <vector>
+#include "bench.hpp"
+#include "reflex.hpp"
+
+namespace
+{
+struct widget
+{
+    float x, y;
+    int id;
+    double weight;
+    float opacity;
+    short layer;
+};
+
+constexpr size_t fields_per_type = 6;
+
+/// @brief A registry of size widget like types, every fourth of which decorates its float fields with a maximum.
+auto registry_of(const int64_t size) -> const reflex::context&
+{
+    static std::vector<std::string> names;
+    static std::vector<std::unique_ptr<reflex::context>> registries;
+    for (auto& ctx : registries) {
+        if (ctx->size() == static_cast<size_t>(size)) return *ctx;
+    }
+
+    auto& ctx = *registries.emplace_back(std::make_unique<reflex::context>());
+    while (names.size() < static_cast<size_t>(size)) names.push_back("widget_" + std::to_string(names.size()));
+    for (int64_t i = 0; i < size; ++i) {
+        reflex::reflector<widget> type{ &ctx, reflex::hashed_string{ names[i].c_str() } };
+        type.field<&widget::x>("x").decorate("min", 0.f);
+        if (i % 4 == 0) type.decorate("max", 1.f);
+        type.field<&widget::y>("y");
+        if (i % 4 == 0) type.decorate("max", 1.f);
+        type.field<&widget::id>("id").decorate("max", 100);
+        type.field<&widget::weight>("weight");
+        type.field<&widget::opacity>("opacity").decorate("min", 0.f);
+        type.field<&widget::layer>("layer");
+    }
+    return ctx;
+}
+
+/// @brief The baseline, walks the field_range of every type through the handle API.
+auto scan_field_ranges(reflex::bench::state& state) -> void
+{
+    const auto& ctx = registry_of(state.arg());
+    std::vector<reflex::type_handle> types;
+    for (int64_t i = 0; i < state.arg(); ++i) {
+        types.push_back(reflex::lookup(ctx, ("widget_" + std::to_string(i)).c_str()));
+    }
+    const reflex::hashed_string float_hash = reflex::internal::alias<float>::hash();
+
+    for (auto _ : state) {
+        size_t matches = 0;
+        for (const reflex::type_handle& type : types) {
+            for (const auto& field : type.fields()) {
+                matches += field.type_hash() == float_hash && field.has_attribute("max");
+            }
+        }
+        reflex::bench::do_not_optimize(matches);
+    }
+    state.set_items_processed(state.iterations() * state.arg() * fields_per_type);
+}
+
+auto scan_field_table(reflex::bench::state& state) -> void
+{
+    const auto& ctx    = registry_of(state.arg());
+    const auto& table  = ctx.field_table();
+    const auto filter  = reflex::field_filter{ }.of_type<float>().with_attribute(reflex::hashed_string{ "max" });
+
+    for (auto _ : state) reflex::bench::do_not_optimize(table.count(filter));
+    state.set_items_processed(state.iterations() * state.arg() * fields_per_type);
+}
+} // namespace
+
+REFLEX_BENCHMARK(scan_field_ranges, 100, 1000, 10000, 100000);
+REFLEX_BENCHMARK(scan_field_table, 100, 1000, 10000, 100000);
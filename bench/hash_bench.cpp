@@ -0,0 +1,41 @@
+#include <string>
+#include <string_view>
+#include <vector>
+#include "bench.hpp"
+#include "reflex.hpp"
+
+namespace
+{
+/// @brief 1024 distinct names of exactly length characters, padded with a qualified template name.
+auto names_of_length(const size_t length) -> std::vector<std::string>
+{
+    constexpr std::string_view padding = "::game::physics::rigid_body<float, std::allocator<float>>";
+    std::vector<std::string> names;
+    for (size_t i = 0; i < 1024; ++i) {
+        std::string name = std::to_string(i);
+        while (name.size() < length) name += padding.substr(0, length - name.size());
+        names.push_back(std::move(name));
+    }
+    return names;
+}
+
+template <typename Hasher>
+auto run_hashes(reflex::bench::state& state) -> void
+{
+    const std::vector<std::string> names = names_of_length(static_cast<size_t>(state.arg()));
+    for (auto _ : state) {
+        for (const std::string& name : names) {
+            reflex::bench::do_not_optimize(reflex::basic_hashed_string<Hasher>{ name.c_str() });
+        }
+    }
+    state.set_items_processed(state.iterations() * names.size());
+    state.set_bytes_processed(state.iterations() * names.size() * static_cast<size_t>(state.arg()));
+}
+
+auto hash_fnv1a(reflex::bench::state& state) -> void { run_hashes<reflex::fnv1a>(state); }
+
+auto hash_wyhash(reflex::bench::state& state) -> void { run_hashes<reflex::wyhash>(state); }
+} // namespace
+
+REFLEX_BENCHMARK(hash_fnv1a, 8, 16, 32, 64, 128);
+REFLEX_BENCHMARK(hash_wyhash, 8, 16, 32, 64, 128);
@@ -0,0 +1,80 @@
+/**
+ * @file hash_report.cpp
+ * @brief Reports how evenly each hash policy spreads registry-like names over power of two bucket counts.
+ *
+ * Tables index buckets by either the low bits of a hash (masking) or its high bits (shifting), so both are
+ * reported. The normalized chi-squared statistic is close to 1 for a uniform spread and grows with every
+ * cluster, the worst bucket is given relative to the mean load.
+ */
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "reflex.hpp"
+
+namespace
+{
+/// @brief Names shaped like those of a large registry: qualified types, template instances, fields and keys.
+auto registry_names() -> std::vector<std::string>
+{
+    std::vector<std::string> names;
+    for (int ns = 0; ns < 50; ++ns) {
+        for (int type = 0; type < 400; ++type) {
+            const std::string qualified = "game::module_" + std::to_string(ns) + "::type_" + std::to_string(type);
+            names.push_back(qualified);
+            names.push_back(qualified + "<float, std::allocator<float>>");
+            names.push_back("field_" + std::to_string(type) + "_" + std::to_string(ns));
+            names.push_back("attr." + std::to_string(ns * 400 + type));
+        }
+    }
+    return names;
+}
+
+struct spread
+{
+    double chi_squared;
+    double worst;
+};
+
+auto measure(const std::vector<uint64_t>& hashes, const int bits, const bool high) -> spread
+{
+    std::vector<uint32_t> buckets(size_t{ 1 } << bits, 0);
+    for (const uint64_t hash : hashes) {
+        ++buckets[high ? hash >> (64 - bits) : hash & (buckets.size() - 1)];
+    }
+    const double expected = static_cast<double>(hashes.size()) / static_cast<double>(buckets.size());
+    double chi_squared    = 0;
+    for (const uint32_t load : buckets) chi_squared += (load - expected) * (load - expected) / expected;
+    return { chi_squared / static_cast<double>(buckets.size() - 1), *std::ranges::max_element(buckets) / expected };
+}
+
+template <typename Hasher>
+auto report(const char* name, const std::vector<std::string>& names) -> void
+{
+    std::vector<uint64_t> hashes;
+    for (const std::string& n : names) hashes.push_back(Hasher::hash(n.data(), n.size()));
+
+    for (const int bits : { 8, 12, 16 }) {
+        const spread low  = measure(hashes, bits, false);
+        const spread high = measure(hashes, bits, true);
+        std::printf(
+                "%-8s %8zu %12.3f %10.2f %12.3f %10.2f\n",
+                name,
+                size_t{ 1 } << bits,
+                low.chi_squared,
+                low.worst,
+                high.chi_squared,
+                high.worst);
+    }
+}
+} // namespace
+
+int main()
+{
+    const std::vector<std::string> names = registry_names();
+    std::printf("%zu names, chi squared / (buckets - 1) is about 1 for a uniform spread\n\n", names.size());
+    std::printf("%-8s %8s %12s %10s %12s %10s\n", "hasher", "buckets", "low chi2", "low worst", "high chi2", "high worst");
+    report<reflex::fnv1a>("fnv1a", names);
+    report<reflex::wyhash>("wyhash", names);
+}
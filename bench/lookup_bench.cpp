@@ -0,0 +1,206 @@
+#include <cstdint>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include "bench.hpp"
+#include "reflex.hpp"
+
+namespace
+{
+template <size_t N>
+struct bench_type
+{
+    int value;
+};
+
+constexpr size_t type_count = 64;
+
+/// @brief Captures bench_type<0> ... bench_type<type_count - 1> into ctx once.
+auto populated_context() -> const reflex::context&
+{
+    static reflex::context ctx;
+    static const bool captured = [] {
+        [&]<size_t... I>(std::index_sequence<I...>) {
+            (reflex::capture<bench_type<I>>(ctx, ("bench_type_" + std::to_string(I)).c_str()), ...);
+        }(std::make_index_sequence<type_count>{ });
+        return true;
+    }();
+    (void)captured;
+    return ctx;
+}
+
+/// @brief The pre dense index lookup path, a hash probe keyed on the cached alias hash.
+template <typename T>
+auto lookup_by_hash(const reflex::context& ctx) -> reflex::type_handle
+{
+    auto* desc = ctx.find(reflex::internal::alias<T>::hash());
+    if (!desc) throw reflex::reflection_error{ "Attempted to lookup type that has not been captured." };
+    return reflex::type_handle{ &ctx, desc };
+}
+
+auto lookup_type_by_hash(reflex::bench::state& state) -> void
+{
+    const auto& ctx = populated_context();
+    for (auto _ : state) {
+        [&]<size_t... I>(std::index_sequence<I...>) {
+            (reflex::bench::do_not_optimize(lookup_by_hash<bench_type<I * 7>>(ctx)), ...);
+        }(std::make_index_sequence<type_count / 8>{ });
+    }
+    state.set_items_processed(state.iterations() * (type_count / 8));
+}
+
+auto lookup_type_by_index(reflex::bench::state& state) -> void
+{
+    const auto& ctx = populated_context();
+    for (auto _ : state) {
+        [&]<size_t... I>(std::index_sequence<I...>) {
+            (reflex::bench::do_not_optimize(reflex::lookup<bench_type<I * 7>>(ctx)), ...);
+        }(std::make_index_sequence<type_count / 8>{ });
+    }
+    state.set_items_processed(state.iterations() * (type_count / 8));
+}
+
+/// @brief Field names shared by every run, hashed_string only references them.
+auto field_names() -> const std::vector<std::string>&
+{
+    static const std::vector<std::string> result = [] {
+        std::vector<std::string> generated;
+        for (size_t i = 0; i < 256; ++i) generated.push_back("field_" + std::to_string(i));
+        return generated;
+    }();
+    return result;
+}
+
+/// @brief A type with fields int fields, captured the way reflector::field does.
+auto wide_type(reflex::context& ctx, const size_t fields) -> const reflex::internal::type_descriptor&
+{
+    const reflex::hashed_string hash{ "wide" };
+    auto* desc = ctx.emplace(hash, reflex::internal::type_descriptor{ { }, fields * sizeof(int), { } }).first;
+    for (size_t i = 0; i < fields; ++i) {
+        const reflex::hashed_string name{ field_names()[i].c_str() };
+        desc->field_names.insert(ctx.storage(), name.value(), static_cast<uint32_t>(i));
+        desc->fields.emplace_back(
+                ctx.storage(),
+                ctx.names().intern(name),
+                ctx.names().intern(reflex::internal::alias<int>::hash()),
+                i * sizeof(int),
+                sizeof(int),
+                true,
+                reflex::internal::attribute_block{ });
+    }
+    return *desc;
+}
+
+/// @brief Fields of the type looked up by name in a random order, so branch prediction can not learn it.
+template <typename Find>
+auto run_field_lookups(reflex::bench::state& state, const Find& find) -> void
+{
+    constexpr size_t probes = 1024;
+
+    const auto fields = static_cast<size_t>(state.arg());
+    reflex::context ctx;
+    const reflex::internal::type_descriptor& desc = wide_type(ctx, fields);
+    const reflex::type_handle type{ &ctx, &desc };
+
+    std::mt19937_64 rng{ fields };
+    std::vector<reflex::hashed_string> order;
+    for (size_t i = 0; i < probes; ++i) order.emplace_back(field_names()[rng() % fields].c_str());
+
+    for (auto _ : state) {
+        for (const reflex::hashed_string& name : order) reflex::bench::do_not_optimize(find(type, desc, name));
+    }
+    state.set_items_processed(state.iterations() * probes);
+}
+
+/// @brief The pre index path, a linear scan comparing the hash of every field.
+auto lookup_field_by_scan(reflex::bench::state& state) -> void
+{
+    run_field_lookups(state, [](const auto&, const auto& desc, const reflex::hashed_string& name) {
+        for (const reflex::internal::field_descriptor& field : desc.fields) {
+            if (field.field_hash == name) return field.offset;
+        }
+        return size_t{ 0 };
+    });
+}
+
+auto lookup_field_by_index(reflex::bench::state& state) -> void
+{
+    run_field_lookups(state, [](const reflex::type_handle& type, const auto&, const reflex::hashed_string& name) {
+        return type.field(name).offset();
+    });
+}
+
+struct slider
+{
+    float value;
+};
+
+/// @brief A field decorated the way an editor widget would be, read back once per frame.
+auto decorated_field() -> reflex::field_handle
+{
+    static reflex::context ctx;
+    static const bool captured = [] {
+        reflex::capture<slider>(ctx, "slider")
+                .field<&slider::value>("value")
+                    .decorate("min", 0.f)
+                    .decorate("max", 100.f)
+                    .decorate("step", 0.5f)
+                    .decorate("default", 50.f);
+        return true;
+    }();
+    (void)captured;
+    return reflex::lookup<slider>(ctx).field("value");
+}
+
+/// @brief Literal keys passed as const char*, hashed on every call.
+auto attribute_by_string_key(reflex::bench::state& state) -> void
+{
+    const reflex::field_handle field = decorated_field();
+    for (auto _ : state) {
+        reflex::bench::do_not_optimize(field.attribute<float>("min"));
+        reflex::bench::do_not_optimize(field.attribute<float>("max"));
+        reflex::bench::do_not_optimize(field.attribute<float>("step"));
+        reflex::bench::do_not_optimize(field.attribute<float>("default"));
+    }
+    state.set_items_processed(state.iterations() * 4);
+}
+
+/// @brief The same keys as _hs literals, hashed at compile time.
+auto attribute_by_literal_key(reflex::bench::state& state) -> void
+{
+    using namespace reflex::literals;
+    const reflex::field_handle field = decorated_field();
+    for (auto _ : state) {
+        reflex::bench::do_not_optimize(field.attribute<float>("min"_hs));
+        reflex::bench::do_not_optimize(field.attribute<float>("max"_hs));
+        reflex::bench::do_not_optimize(field.attribute<float>("step"_hs));
+        reflex::bench::do_not_optimize(field.attribute<float>("default"_hs));
+    }
+    state.set_items_processed(state.iterations() * 4);
+}
+
+auto lookup_type_by_string_name(reflex::bench::state& state) -> void
+{
+    const auto& ctx = populated_context();
+    for (auto _ : state) reflex::bench::do_not_optimize(reflex::lookup(ctx, "bench_type_42"));
+    state.set_items_processed(state.iterations());
+}
+
+auto lookup_type_by_literal_name(reflex::bench::state& state) -> void
+{
+    using namespace reflex::literals;
+    const auto& ctx = populated_context();
+    for (auto _ : state) reflex::bench::do_not_optimize(reflex::lookup(ctx, "bench_type_42"_hs));
+    state.set_items_processed(state.iterations());
+}
+} // namespace
+
+REFLEX_BENCHMARK(lookup_type_by_hash);
+REFLEX_BENCHMARK(lookup_type_by_index);
+REFLEX_BENCHMARK(lookup_field_by_scan, 4, 16, 64, 256);
+REFLEX_BENCHMARK(lookup_field_by_index, 4, 16, 64, 256);
+REFLEX_BENCHMARK(attribute_by_string_key);
+REFLEX_BENCHMARK(attribute_by_literal_key);
+REFLEX_BENCHMARK(lookup_type_by_string_name);
+REFLEX_BENCHMARK(lookup_type_by_literal_name);
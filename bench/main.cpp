@@ -0,0 +1,6 @@
+#include "bench.hpp"
+
+int main(int argc, char* argv[])
+{
+    return reflex::bench::run_all(argc, argv);
+}
@@ -0,0 +1,119 @@
+#include <cstring>
+#include <vector>
+#include "bench.hpp"
+#include "reflex.hpp"
+
+namespace
+{
+struct component { };
+
+struct pos_component : component
+{
+    float x, y, z;
+    int layer;
+    double weight;
+};
+} // namespace
+
+template <>
+struct reflex::meta<pos_component>
+{
+    static constexpr auto fields = std::tuple{
+        reflex::field<&pos_component::x>{ "x" },
+        reflex::field<&pos_component::y>{ "y" },
+        reflex::field<&pos_component::z>{ "z" },
+        reflex::field<&pos_component::layer>{ "layer" },
+        reflex::field<&pos_component::weight>{ "weight" },
+    };
+};
+
+namespace
+{
+auto make_components(const size_t count) -> std::vector<pos_component>
+{
+    std::vector<pos_component> components(count);
+    for (size_t i = 0; i < count; ++i) {
+        const auto f  = static_cast<float>(i);
+        components[i] = pos_component{ { }, f, f * 2, f * 3, static_cast<int>(i), f * 0.5 };
+    }
+    return components;
+}
+
+template <typename V>
+auto hash_value(uint64_t seed, const V& value) -> uint64_t
+{
+    uint64_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(value));
+    return (seed ^ bits) * 0x100000001B3ull;
+}
+
+auto hand_written_hash(reflex::bench::state& state) -> void
+{
+    const auto components = make_components(1024);
+    for (auto _ : state) {
+        uint64_t seed = 0;
+        for (const auto& c : components) {
+            seed = hash_value(seed, c.x);
+            seed = hash_value(seed, c.y);
+            seed = hash_value(seed, c.z);
+            seed = hash_value(seed, c.layer);
+            seed = hash_value(seed, c.weight);
+        }
+        reflex::bench::do_not_optimize(seed);
+    }
+    state.set_items_processed(state.iterations() * components.size());
+}
+
+auto for_each_field_hash(reflex::bench::state& state) -> void
+{
+    const auto components = make_components(1024);
+    for (auto _ : state) {
+        uint64_t seed = 0;
+        for (const auto& c : components) {
+            reflex::for_each_field(c, [&](const char*, const auto& value) { seed = hash_value(seed, value); });
+        }
+        reflex::bench::do_not_optimize(seed);
+    }
+    state.set_items_processed(state.iterations() * components.size());
+}
+
+auto hand_written_serialize(reflex::bench::state& state) -> void
+{
+    const auto components = make_components(1024);
+    std::vector<unsigned char> buffer(components.size() * sizeof(pos_component));
+    for (auto _ : state) {
+        unsigned char* out = buffer.data();
+        for (const auto& c : components) {
+            std::memcpy(out, &c.x, sizeof(c.x)), out += sizeof(c.x);
+            std::memcpy(out, &c.y, sizeof(c.y)), out += sizeof(c.y);
+            std::memcpy(out, &c.z, sizeof(c.z)), out += sizeof(c.z);
+            std::memcpy(out, &c.layer, sizeof(c.layer)), out += sizeof(c.layer);
+            std::memcpy(out, &c.weight, sizeof(c.weight)), out += sizeof(c.weight);
+        }
+        reflex::bench::do_not_optimize(buffer.data());
+    }
+    state.set_items_processed(state.iterations() * components.size());
+}
+
+auto for_each_field_serialize(reflex::bench::state& state) -> void
+{
+    const auto components = make_components(1024);
+    std::vector<unsigned char> buffer(components.size() * sizeof(pos_component));
+    for (auto _ : state) {
+        unsigned char* out = buffer.data();
+        for (const auto& c : components) {
+            reflex::for_each_field(c, [&](const char*, const auto& value) {
+                std::memcpy(out, &value, sizeof(value));
+                out += sizeof(value);
+            });
+        }
+        reflex::bench::do_not_optimize(buffer.data());
+    }
+    state.set_items_processed(state.iterations() * components.size());
+}
+} // namespace
+
+REFLEX_BENCHMARK(hand_written_hash);
+REFLEX_BENCHMARK(for_each_field_hash);
+REFLEX_BENCHMARK(hand_written_serialize);
+REFLEX_BENCHMARK(for_each_field_serialize);
@@ -0,0 +1,75 @@
+#include "bench.hpp"
+#include "reflex.hpp"
+
+namespace
+{
+struct command_target
+{
+    float accumulated = 0.f;
+
+    // kept out of line so the direct call is a real call, like any dispatch across translation units
+    [[gnu::noinline]] auto apply(const int count, const float weight) -> float
+    {
+        accumulated += static_cast<float>(count) * weight;
+        return accumulated;
+    }
+};
+
+auto captured() -> const reflex::context&
+{
+    static reflex::context ctx;
+    static const bool done = [] {
+        reflex::capture<command_target>(ctx, "command_target").method<&command_target::apply>("apply");
+        return true;
+    }();
+    (void)done;
+    return ctx;
+}
+
+auto direct_call(reflex::bench::state& state) -> void
+{
+    command_target target;
+    int count    = 1;
+    float weight = 0.5f;
+    for (auto _ : state) {
+        reflex::bench::do_not_optimize(count);
+        reflex::bench::do_not_optimize(target.apply(count, weight));
+    }
+    state.set_items_processed(state.iterations());
+}
+
+/// @brief The raw interface, arguments are passed by address from a buffer on the stack.
+auto method_invoke(reflex::bench::state& state) -> void
+{
+    const reflex::method_handle apply = reflex::lookup<command_target>(captured()).method("apply");
+    command_target target;
+    int count    = 1;
+    float weight = 0.5f;
+    void* args[] = { &count, &weight };
+    float result = 0.f;
+    for (auto _ : state) {
+        reflex::bench::do_not_optimize(count);
+        apply.invoke(&target, args, &result);
+        reflex::bench::do_not_optimize(result);
+    }
+    state.set_items_processed(state.iterations());
+}
+
+/// @brief The typed interface, which packs the argument buffer itself.
+auto method_call(reflex::bench::state& state) -> void
+{
+    const reflex::method_handle apply = reflex::lookup<command_target>(captured()).method("apply");
+    command_target target;
+    int count    = 1;
+    float weight = 0.5f;
+    for (auto _ : state) {
+        reflex::bench::do_not_optimize(count);
+        reflex::bench::do_not_optimize(apply.call<float>(&target, count, weight));
+    }
+    state.set_items_processed(state.iterations());
+}
+} // namespace
+
+REFLEX_BENCHMARK(direct_call);
+REFLEX_BENCHMARK(method_invoke);
+REFLEX_BENCHMARK(method_call);
@@ -0,0 +1,106 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+#include "bench.hpp"
+#include "reflex.hpp"
+
+namespace
+{
+struct position
+{
+    float x, y, z;
+};
+
+struct transform
+{
+    position local;
+    position world;
+    float scale;
+};
+
+struct entity
+{
+    int id;
+    float health;
+    transform xform;
+};
+
+constexpr std::string_view world_z = "transform.world.z";
+
+auto captured() -> const reflex::context&
+{
+    static reflex::context ctx;
+    static const bool done = [] {
+        reflex::capture<position>(ctx, "position")
+                .field<&position::x>("x")
+                .field<&position::y>("y")
+                .field<&position::z>("z");
+        reflex::capture<transform>(ctx, "transform")
+                .field<&transform::local>("local")
+                .field<&transform::world>("world")
+                .field<&transform::scale>("scale");
+        reflex::capture<entity>(ctx, "entity")
+                .field<&entity::id>("id")
+                .field<&entity::health>("health")
+                .field<&entity::xform>("transform");
+        return true;
+    }();
+    (void)done;
+    return ctx;
+}
+
+/// @brief The baseline, resolves every segment on each access by scanning fields and looking up their type.
+auto access_by_field_chain(reflex::bench::state& state) -> void
+{
+    const auto& ctx = captured();
+    entity e{ };
+
+    for (auto _ : state) {
+        reflex::type_handle type = reflex::lookup<entity>(ctx);
+        size_t offset            = 0;
+        const float* value       = nullptr;
+        for (size_t begin = 0; !value;) {
+            const size_t end               = std::min(world_z.find('.', begin), world_z.size());
+            const std::string_view segment = world_z.substr(begin, end - begin);
+            for (const auto& field : type.fields()) {
+                if (std::strlen(field.name()) != segment.size() || segment != field.name()) continue;
+                offset += field.offset();
+                if (end == world_z.size()) {
+                    value = reinterpret_cast<const float*>(reinterpret_cast<const std::byte*>(&e) + offset);
+                } else {
+                    type = field.type();
+                }
+                break;
+            }
+            begin = end + 1;
+        }
+        reflex::bench::do_not_optimize(*value);
+    }
+    state.set_items_processed(state.iterations());
+}
+
+auto access_by_path(reflex::bench::state& state) -> void
+{
+    const reflex::path z{ reflex::lookup<entity>(captured()), world_z };
+    entity e{ };
+
+    for (auto _ : state) {
+        reflex::bench::do_not_optimize(&e);
+        reflex::bench::do_not_optimize(z.get<float>(&e));
+    }
+    state.set_items_processed(state.iterations());
+}
+
+/// @brief What precompiling saves, the path is compiled anew on every access.
+auto compile_path(reflex::bench::state& state) -> void
+{
+    const reflex::type_handle root = reflex::lookup<entity>(captured());
+    for (auto _ : state) reflex::bench::do_not_optimize(reflex::path{ root, world_z }.offset());
+    state.set_items_processed(state.iterations());
+}
+} // namespace
+
+REFLEX_BENCHMARK(access_by_field_chain);
+REFLEX_BENCHMARK(access_by_path);
+REFLEX_BENCHMARK(compile_path);
@@ -0,0 +1,163 @@
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include "bench.hpp"
+#include "reflex.hpp"
+
+// Measures the public API against registries of 10 to 100k types. The captured bench types are mixed into a
+// registry padded with runtime named filler types, so the smallest registries hold a few more types than asked.
+
+namespace
+{
+struct vec3
+{
+    float x, y, z;
+};
+
+template <size_t N>
+struct bench_component
+{
+    vec3 position;
+    vec3 velocity;
+    float mass;
+    int layer;
+};
+
+/// @brief Stands in for the bulk of a registry, captured under runtime generated names.
+struct filler
+{
+    float a, b, c;
+};
+
+constexpr size_t captured_types = 16;
+
+auto filler_names(const size_t count) -> const std::vector<std::string>&
+{
+    static std::vector<std::string> names;
+    while (names.size() < count) names.push_back("filler_" + std::to_string(names.size()));
+    return names;
+}
+
+auto capture_filler(reflex::context& ctx, const char* name) -> void
+{
+    reflex::reflector<filler>(&ctx, reflex::hashed_string{ name })
+            .field<&filler::a>("a")
+                .decorate("min", 0.f)
+            .field<&filler::b>("b")
+            .field<&filler::c>("c");
+}
+
+template <size_t N>
+auto capture_component(reflex::context& ctx) -> void
+{
+    static const std::string name = "bench_component_" + std::to_string(N);
+    reflex::capture<bench_component<N>>(ctx, name.c_str())
+            .template field<&bench_component<N>::position>("position")
+                .decorate("min", 0.f)
+                .decorate("max", 100.f)
+            .template field<&bench_component<N>::velocity>("velocity")
+            .template field<&bench_component<N>::mass>("mass")
+                .decorate("min", 0.f)
+            .template field<&bench_component<N>::layer>("layer");
+}
+
+/// @brief A registry of exactly size types, built once per size and shared by every lookup benchmark.
+auto registry_of(const int64_t size) -> const reflex::context&
+{
+    static std::map<int64_t, std::unique_ptr<reflex::context>> registries;
+    auto& ctx = registries[size];
+    if (ctx) return *ctx;
+
+    ctx = std::make_unique<reflex::context>();
+    reflex::capture<vec3>(*ctx, "vec3").field<&vec3::x>("x").field<&vec3::y>("y").field<&vec3::z>("z");
+    [&]<size_t... I>(std::index_sequence<I...>) {
+        (capture_component<I>(*ctx), ...);
+    }(std::make_index_sequence<captured_types>{ });
+
+    const auto& names = filler_names(static_cast<size_t>(size));
+    for (size_t i = ctx->size(); i < static_cast<size_t>(size); ++i) capture_filler(*ctx, names[i].c_str());
+    return *ctx;
+}
+
+auto capture_registry(reflex::bench::state& state) -> void
+{
+    const auto count  = static_cast<size_t>(state.arg());
+    const auto& names = filler_names(count);
+    for (auto _ : state) {
+        reflex::context ctx;
+        for (size_t i = 0; i < count; ++i) capture_filler(ctx, names[i].c_str());
+        reflex::bench::do_not_optimize(ctx.size());
+        state.pause_timing();
+        ctx = reflex::context{ };
+        state.resume_timing();
+    }
+    state.set_items_processed(state.iterations() * count);
+}
+
+auto lookup_type(reflex::bench::state& state) -> void
+{
+    const auto& ctx = registry_of(state.arg());
+    for (auto _ : state) {
+        [&]<size_t... I>(std::index_sequence<I...>) {
+            (reflex::bench::do_not_optimize(reflex::lookup<bench_component<I>>(ctx)), ...);
+        }(std::make_index_sequence<captured_types>{ });
+    }
+    state.set_items_processed(state.iterations() * captured_types);
+}
+
+auto lookup_name(reflex::bench::state& state) -> void
+{
+    const auto& ctx     = registry_of(state.arg());
+    const auto count    = static_cast<size_t>(state.arg());
+    const auto& fillers = filler_names(count);
+
+    // every name but the captured components, which are reached through lookup<T> above
+    std::vector<std::string> names{ "vec3" };
+    for (size_t i = captured_types + 1; i < count; ++i) names.push_back(fillers[i]);
+    std::shuffle(names.begin(), names.end(), std::mt19937_64{ 42 });
+
+    size_t i = 0;
+    for (auto _ : state) {
+        reflex::bench::do_not_optimize(reflex::lookup(ctx, names[i].c_str()));
+        if (++i == names.size()) i = 0;
+    }
+    state.set_items_processed(state.iterations());
+}
+
+auto fields_iteration(reflex::bench::state& state) -> void
+{
+    const auto type = reflex::lookup<bench_component<0>>(registry_of(state.arg()));
+    for (auto _ : state) {
+        size_t sum = 0;
+        for (const auto& field : type.fields()) sum += field.offset();
+        reflex::bench::do_not_optimize(sum);
+    }
+    state.set_items_processed(state.iterations());
+}
+
+auto field_type(reflex::bench::state& state) -> void
+{
+    const auto type  = reflex::lookup<bench_component<0>>(registry_of(state.arg()));
+    const auto field = *type.fields().begin();
+    for (auto _ : state) reflex::bench::do_not_optimize(field.type());
+    state.set_items_processed(state.iterations());
+}
+
+auto field_attribute(reflex::bench::state& state) -> void
+{
+    const auto type  = reflex::lookup<bench_component<0>>(registry_of(state.arg()));
+    const auto field = *type.fields().begin();
+    for (auto _ : state) reflex::bench::do_not_optimize(field.attribute<float>("max"));
+    state.set_items_processed(state.iterations());
+}
+} // namespace
+
+REFLEX_BENCHMARK(capture_registry, 10, 100, 1000, 10000, 100000);
+REFLEX_BENCHMARK(lookup_type, 10, 100, 1000, 10000, 100000);
+REFLEX_BENCHMARK(lookup_name, 10, 100, 1000, 10000, 100000);
+REFLEX_BENCHMARK(fields_iteration, 10, 100, 1000, 10000, 100000);
+REFLEX_BENCHMARK(field_type, 10, 100, 1000, 10000, 100000);
+REFLEX_BENCHMARK(field_attribute, 10, 100, 1000, 10000, 100000);
@@ -0,0 +1,91 @@
+#include <vector>
+#include "bench.hpp"
+#include "reflex.hpp"
+
+namespace
+{
+struct vec3
+{
+    float x, y, z;
+};
+
+/// @brief Tightly packed, serialized with a single memcpy for the whole array.
+struct particle
+{
+    vec3 position;
+    vec3 velocity;
+};
+
+/// @brief Has padding after id and flags, serialized as one memcpy run per padded gap.
+struct padded_particle
+{
+    uint8_t id;
+    vec3 position;
+    uint16_t flags;
+    double mass;
+};
+
+constexpr size_t object_count = 1'000'000;
+
+auto serialize_context() -> const reflex::context&
+{
+    static const reflex::context& ctx = []() -> const reflex::context& {
+        static reflex::context c;
+        reflex::capture<vec3>(c, "vec3").field<&vec3::x>("x").field<&vec3::y>("y").field<&vec3::z>("z");
+        reflex::capture<particle>(c, "particle")
+                .field<&particle::position>("position")
+                .field<&particle::velocity>("velocity");
+        reflex::capture<padded_particle>(c, "padded_particle")
+                .field<&padded_particle::id>("id")
+                .field<&padded_particle::position>("position")
+                .field<&padded_particle::flags>("flags")
+                .field<&padded_particle::mass>("mass");
+        return c;
+    }();
+    return ctx;
+}
+
+template <typename T>
+auto bench_write(reflex::bench::state& state) -> void
+{
+    const auto& ctx = serialize_context();
+    const std::vector<T> objects(object_count);
+    std::vector<std::byte> buffer(object_count * sizeof(T));
+
+    size_t written = 0;
+    for (auto _ : state) {
+        reflex::binary_writer writer{ ctx, buffer };
+        writer.write(std::span{ objects });
+        written = writer.size();
+        reflex::bench::do_not_optimize(buffer.data());
+    }
+    state.set_bytes_processed(state.iterations() * written);
+}
+
+template <typename T>
+auto bench_read(reflex::bench::state& state) -> void
+{
+    const auto& ctx = serialize_context();
+    std::vector<T> objects(object_count);
+    std::vector<std::byte> buffer(object_count * sizeof(T));
+    reflex::binary_writer writer{ ctx, buffer };
+    writer.write(std::span{ objects });
+
+    for (auto _ : state) {
+        reflex::binary_reader reader{ ctx, writer.data() };
+        reader.read(std::span{ objects });
+        reflex::bench::do_not_optimize(objects.data());
+    }
+    state.set_bytes_processed(state.iterations() * writer.size());
+}
+
+auto write_packed(reflex::bench::state& state) -> void { bench_write<particle>(state); }
+auto read_packed(reflex::bench::state& state) -> void { bench_read<particle>(state); }
+auto write_padded(reflex::bench::state& state) -> void { bench_write<padded_particle>(state); }
+auto read_padded(reflex::bench::state& state) -> void { bench_read<padded_particle>(state); }
+} // namespace
+
+REFLEX_BENCHMARK(write_packed);
+REFLEX_BENCHMARK(read_packed);
+REFLEX_BENCHMARK(write_padded);
+REFLEX_BENCHMARK(read_padded);
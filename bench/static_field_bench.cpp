@@ -0,0 +1,42 @@
+#include "bench.hpp"
+#include "reflex.hpp"
+
+namespace
+{
+struct physics_tuning
+{
+    static inline float gravity = 9.81f;
+};
+
+auto captured() -> const reflex::context&
+{
+    static reflex::context ctx;
+    static const bool done = [] {
+        reflex::capture<physics_tuning>(ctx, "physics_tuning").field<&physics_tuning::gravity>("gravity");
+        return true;
+    }();
+    (void)done;
+    return ctx;
+}
+
+auto static_field_direct(reflex::bench::state& state) -> void
+{
+    for (auto _ : state) {
+        reflex::bench::do_not_optimize(physics_tuning::gravity);
+    }
+    state.set_items_processed(state.iterations());
+}
+
+/// @brief Reads through a handle resolved once, a console would keep it next to the widget it drives.
+auto static_field_handle(reflex::bench::state& state) -> void
+{
+    const reflex::field_handle gravity = reflex::lookup<physics_tuning>(captured()).field("gravity");
+    for (auto _ : state) {
+        reflex::bench::do_not_optimize(gravity.get<float>());
+    }
+    state.set_items_processed(state.iterations());
+}
+} // namespace
+
+REFLEX_BENCHMARK(static_field_direct);
+REFLEX_BENCHMARK(static_field_handle);
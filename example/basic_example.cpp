@@ -26,7 +26,10 @@ enum widget_type
 /// basic yaml output of a struct
 int main(int argc, char* argv[])
 {
+    reflex::capture_enum<widget_type>("widget_type").values<SLIDER, INPUT, SOMETHING>();
+    reflex::capture<component>("component");
     reflex::capture<pos_component>("pos_component")
+            .base<component>()
             .field<&pos_component::x>("x")
                 .decorate("min", 1.f)
                 .decorate("max", 100.f)
@@ -43,10 +46,13 @@ int main(int argc, char* argv[])
     pos_component pos{ 1, 2, 3 };
 
     std::cout << "name: " << reflex::lookup("pos_component").name() << std::endl;
+    std::cout << "is a component: " << reflex::lookup<pos_component>().is_a<component>() << std::endl;
 
     for (const auto& field : reflex::lookup("pos_component").fields()) {
-        std::cout << "\t" << field.name() << ": " << field.name() << std::endl;
-        std::cout << "\t\t" << "min" << ": " << std::any_cast<float>(field.attribute("min")) << std::endl;
-        std::cout << "\t\t" << "max" << ": " << std::any_cast<float>(field.attribute("max")) << std::endl;
+        std::cout << "\t" << field.name() << ": " << field.get<float>(&pos) << std::endl;
+        std::cout << "\t\t" << "min" << ": " << field.attribute<float>("min") << std::endl;
+        std::cout << "\t\t" << "max" << ": " << field.attribute<float>("max") << std::endl;
+        std::cout << "\t\t" << "widget" << ": " << reflex::enum_name(field.attribute<widget_type>("widget"))
+                  << std::endl;
     }
 }
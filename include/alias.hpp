@@ -1,18 +1,71 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <mutex>
 #include "hashed_string.hpp"
+#include "string_interner.hpp"
+#include "type_name.hpp"
 
 
 namespace reflex::internal
 {
+/// @brief The index of a type that has never been captured.
+constexpr uint32_t invalid_index = UINT32_MAX;
+
+/**
+ * @brief Hands out dense type indices, shared by every context.
+ */
+inline auto next_type_index() noexcept -> uint32_t
+{
+    static std::atomic<uint32_t> counter{ 0 };
+    return counter.fetch_add(1, std::memory_order_relaxed);
+}
+
 template <typename T>
 struct alias
 {
-    explicit alias(const char* str) { if (!hash.data()) hash = hashed_string{ str }; }
+    /**
+     * @brief Claims a dense index for T, keeping the name deduced at compile time.
+     */
+    alias()
+    {
+        std::call_once(captured, [] { index.store(next_type_index(), std::memory_order_release); });
+    }
+
+    /**
+     * @brief Claims a dense index for T. The first capture of T decides its name, so str replaces the
+     * deduced name only if T has never been captured before. str is copied, it need not outlive the call.
+     */
+    explicit alias(const char* str)
+    {
+        std::call_once(captured, [str] {
+            named = intern_static(hashed_string{ str });
+            name.store(&named, std::memory_order_release);
+            index.store(next_type_index(), std::memory_order_release);
+        });
+    }
+
+    /**
+     * @brief The name T is captured under, the deduced one unless an explicit name was supplied on first
+     * capture. Safe to call while another thread captures T for the first time.
+     */
+    [[nodiscard]] static auto hash() noexcept -> hashed_string { return *name.load(std::memory_order_acquire); }
+
+    /// @brief The hash of the compiler spelled name of T, computed at compile time.
+    static constexpr hashed_string deduced{ type_name<T>() };
+
+    /// @brief The explicit name supplied on first capture, written once before it is published in name.
+    static constinit inline hashed_string named{ };
+
+    /// @brief Points at deduced, so no startup code runs for it, until an explicit name is published.
+    static constinit inline std::atomic<const hashed_string*> name{ &deduced };
+
+    /// @brief A dense per-type index assigned on first capture, used to look T
+    /// up by position instead of by hash.
+    static constinit inline std::atomic<uint32_t> index{ invalid_index };
 
-    /// @brief A per-type cached hash value. Constructing an alias with a
-    /// string will initialize the static hash for that type so later lookups
-    /// can reference it without supplying the name again.
-    static inline hashed_string hash;
+    /// @brief Makes the first capture of T safe to race between threads.
+    static inline std::once_flag captured;
 };
 } // namespace internal
@@ -0,0 +1,210 @@
+/**
+ * @file arena.hpp
+ * @brief A monotonic bump allocator owned by a context.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace reflex::internal
+{
+/**
+ * @brief Hands out memory by bumping a pointer through large chunks, everything is released at once
+ * when the arena is destroyed. Objects placed in the arena are never destructed by it.
+ */
+class arena
+{
+public:
+    static constexpr size_t default_chunk_size = 16 * 1024;
+
+    arena() = default;
+
+    arena(const arena&)                    = delete;
+    auto operator=(const arena&) -> arena& = delete;
+
+    arena(arena&& other) noexcept :
+        m_chunks(std::move(other.m_chunks)),
+        m_cursor(std::exchange(other.m_cursor, nullptr)),
+        m_end(std::exchange(other.m_end, nullptr)),
+        m_allocations(std::exchange(other.m_allocations, 0)),
+        m_bytes(std::exchange(other.m_bytes, 0)),
+        m_reserved(std::exchange(other.m_reserved, 0)) { }
+
+    auto operator=(arena&& other) noexcept -> arena&
+    {
+        arena{ std::move(other) }.swap(*this);
+        return *this;
+    }
+
+    auto swap(arena& other) noexcept -> void
+    {
+        std::swap(m_chunks, other.m_chunks);
+        std::swap(m_cursor, other.m_cursor);
+        std::swap(m_end, other.m_end);
+        std::swap(m_allocations, other.m_allocations);
+        std::swap(m_bytes, other.m_bytes);
+        std::swap(m_reserved, other.m_reserved);
+    }
+
+    /**
+     * @brief Returns size bytes aligned to align, valid until the arena is destroyed.
+     */
+    [[nodiscard]] auto allocate(const size_t size, const size_t align = alignof(std::max_align_t)) -> void*
+    {
+        auto cursor       = reinterpret_cast<uintptr_t>(m_cursor);
+        uintptr_t aligned = (cursor + align - 1) & ~(uintptr_t{ align } - 1);
+        if (!m_cursor || aligned + size > reinterpret_cast<uintptr_t>(m_end)) {
+            const size_t chunk_size = std::max(default_chunk_size, size + align);
+            m_cursor                = m_chunks.emplace_back(std::make_unique_for_overwrite<std::byte[]>(chunk_size)).get();
+            m_end                   = m_cursor + chunk_size;
+            cursor                  = reinterpret_cast<uintptr_t>(m_cursor);
+            aligned                 = (cursor + align - 1) & ~(uintptr_t{ align } - 1);
+            m_reserved += chunk_size;
+        }
+        m_cursor = reinterpret_cast<std::byte*>(aligned + size);
+        ++m_allocations;
+        m_bytes += size;
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    /**
+     * @brief Allocates and constructs a T in the arena. Its destructor is the caller's responsibility.
+     */
+    template <typename T, typename... Args>
+    [[nodiscard]] auto create(Args&&... args) -> T*
+    {
+        return ::new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Allocates uninitialized storage for count objects of type T.
+     */
+    template <typename T>
+    [[nodiscard]] auto allocate_array(const size_t count) -> T*
+    {
+        return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    /**
+     * @brief Copies the null terminated string str of length characters into the arena.
+     */
+    [[nodiscard]] auto copy_string(const char* str, const size_t length) -> const char*
+    {
+        auto* copy = static_cast<char*>(allocate(length + 1, alignof(char)));
+        std::memcpy(copy, str, length);
+        copy[length] = '\0';
+        return copy;
+    }
+
+    /// @brief The number of allocations served, each would otherwise have been a separate heap allocation.
+    [[nodiscard]] auto allocations() const noexcept -> size_t { return m_allocations; }
+    /// @brief The number of bytes handed out, excluding alignment padding.
+    [[nodiscard]] auto bytes_allocated() const noexcept -> size_t { return m_bytes; }
+    /// @brief The number of chunks obtained from the heap.
+    [[nodiscard]] auto chunks() const noexcept -> size_t { return m_chunks.size(); }
+    /// @brief The total size of all chunks.
+    [[nodiscard]] auto bytes_reserved() const noexcept -> size_t { return m_reserved; }
+
+private:
+    std::vector<std::unique_ptr<std::byte[]>> m_chunks;
+    std::byte* m_cursor  = nullptr;
+    std::byte* m_end     = nullptr;
+    size_t m_allocations = 0;
+    size_t m_bytes       = 0;
+    size_t m_reserved    = 0;
+};
+
+/**
+ * @brief A growable array whose storage is bump allocated from an arena.
+ *
+ * Growing abandons the previous storage to the arena, with geometric growth at most half of the space
+ * taken by an array is wasted. Elements are destroyed with the array, its storage with the arena.
+ */
+template <typename T>
+class arena_array
+{
+public:
+    arena_array() = default;
+
+    arena_array(const arena_array&)                    = delete;
+    auto operator=(const arena_array&) -> arena_array& = delete;
+
+    arena_array(arena_array&& other) noexcept :
+        m_data(std::exchange(other.m_data, nullptr)),
+        m_size(std::exchange(other.m_size, 0)),
+        m_capacity(std::exchange(other.m_capacity, 0)) { }
+
+    auto operator=(arena_array&& other) noexcept -> arena_array&
+    {
+        if (this != &other) {
+            destroy();
+            m_data     = std::exchange(other.m_data, nullptr);
+            m_size     = std::exchange(other.m_size, 0);
+            m_capacity = std::exchange(other.m_capacity, 0);
+        }
+        return *this;
+    }
+
+    ~arena_array() { destroy(); }
+
+    template <typename... Args>
+    auto emplace_back(arena& storage, Args&&... args) -> T&
+    {
+        if (m_size == m_capacity) reserve(storage, m_capacity ? m_capacity * 2 : 4);
+        return *::new (m_data + m_size++) T(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Makes room for at least capacity elements, moving existing ones into new storage if needed.
+     */
+    auto reserve(arena& storage, const size_t capacity) -> void
+    {
+        if (capacity <= m_capacity) return;
+        T* data = storage.allocate_array<T>(capacity);
+        for (size_t i = 0; i < m_size; ++i) {
+            ::new (data + i) T(std::move(m_data[i]));
+            m_data[i].~T();
+        }
+        m_data     = data;
+        m_capacity = capacity;
+    }
+
+    [[nodiscard]] auto operator[](const size_t index) noexcept -> T& { return m_data[index]; }
+    [[nodiscard]] auto operator[](const size_t index) const noexcept -> const T& { return m_data[index]; }
+
+    [[nodiscard]] auto back() noexcept -> T& { return m_data[m_size - 1]; }
+    [[nodiscard]] auto data() noexcept -> T* { return m_data; }
+    [[nodiscard]] auto data() const noexcept -> const T* { return m_data; }
+
+    [[nodiscard]] auto begin() noexcept -> T* { return m_data; }
+    [[nodiscard]] auto end() noexcept -> T* { return m_data + m_size; }
+    [[nodiscard]] auto begin() const noexcept -> const T* { return m_data; }
+    [[nodiscard]] auto end() const noexcept -> const T* { return m_data + m_size; }
+
+    [[nodiscard]] auto size() const noexcept -> size_t { return m_size; }
+    [[nodiscard]] auto empty() const noexcept -> bool { return m_size == 0; }
+
+private:
+    auto destroy() noexcept -> void
+    {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (size_t i = 0; i < m_size; ++i) m_data[i].~T();
+        }
+        m_data = nullptr;
+        m_size = m_capacity = 0;
+    }
+
+    T* m_data         = nullptr;
+    size_t m_size     = 0;
+    size_t m_capacity = 0;
+};
+} // namespace reflex::internal
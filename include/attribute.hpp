@@ -0,0 +1,212 @@
+/**
+ * @file attribute.hpp
+ * @brief Compact typed storage for the user defined attributes of a field.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "arena.hpp"
+
+
+namespace reflex::internal
+{
+/**
+ * @brief Per-type operations for a type erased attribute value. Its address doubles as the type tag.
+ */
+struct value_ops
+{
+    /// @brief Destroys an out of line value, nullptr when there is nothing to do.
+    void (*destroy)(void*);
+    /// @brief Whether the value lives inside attribute::payload rather than in the arena.
+    bool stored_inline;
+    /// @brief Copies an out of line value into an arena, nullptr if the value can not be copied.
+    void* (*clone)(arena&, const void*);
+};
+
+/// @brief Values at most this large which are trivially copyable are stored without indirection.
+constexpr size_t inline_attribute_size = 16;
+
+template <typename T>
+constexpr bool fits_inline = std::is_trivially_copyable_v<T> &&
+                             sizeof(T) <= inline_attribute_size &&
+                             alignof(T) <= alignof(uint64_t);
+
+template <typename T>
+inline constexpr value_ops value_ops_of{
+    std::is_trivially_destructible_v<T> ? nullptr : +[](void* value) { static_cast<T*>(value)->~T(); },
+    fits_inline<T>,
+    std::is_copy_constructible_v<T> ? +[](arena& storage, const void* value) -> void* {
+        if constexpr (std::is_copy_constructible_v<T>) {
+            return storage.create<T>(*static_cast<const T*>(value));
+        } else {
+            return nullptr;
+        }
+    } : nullptr,
+};
+
+/**
+ * @brief A single attribute, either holding its value inline or pointing at it in the context arena.
+ */
+struct attribute
+{
+    uint64_t key;
+    const value_ops* type;
+    alignas(uint64_t) unsigned char payload[inline_attribute_size];
+
+    template <typename T>
+    [[nodiscard]] auto get() const noexcept -> const T*
+    {
+        if (type != &value_ops_of<T>) return nullptr;
+        if constexpr (fits_inline<T>) {
+            return std::launder(reinterpret_cast<const T*>(payload));
+        } else {
+            return static_cast<const T*>(out_of_line());
+        }
+    }
+
+    [[nodiscard]] auto out_of_line() const noexcept -> void*
+    {
+        void* value;
+        std::memcpy(&value, payload, sizeof(value));
+        return value;
+    }
+};
+
+/**
+ * @brief A small vector of attributes sorted by key, its storage is bump allocated from a context arena.
+ *
+ * Trivially copyable values of up to 16 bytes are stored inline, anything else is placed in the arena
+ * and destroyed together with the block.
+ */
+class attribute_block
+{
+public:
+    attribute_block() = default;
+
+    attribute_block(const attribute_block&)                    = delete;
+    auto operator=(const attribute_block&) -> attribute_block& = delete;
+
+    attribute_block(attribute_block&& other) noexcept :
+        m_data(std::exchange(other.m_data, nullptr)),
+        m_size(std::exchange(other.m_size, 0)),
+        m_capacity(std::exchange(other.m_capacity, 0)) { }
+
+    auto operator=(attribute_block&& other) noexcept -> attribute_block&
+    {
+        if (this != &other) {
+            destroy();
+            m_data     = std::exchange(other.m_data, nullptr);
+            m_size     = std::exchange(other.m_size, 0);
+            m_capacity = std::exchange(other.m_capacity, 0);
+        }
+        return *this;
+    }
+
+    ~attribute_block() { destroy(); }
+
+    /**
+     * @brief Stores value under key unless the key is already present.
+     * @return Whether the value has been stored.
+     */
+    template <typename T>
+    auto emplace(arena& storage, const uint64_t key, T&& value) -> bool
+    {
+        using value_type = std::decay_t<T>;
+
+        attribute* const end = m_data + m_size;
+        attribute* pos       = std::lower_bound(m_data, end, key, [](const attribute& a, const uint64_t k) {
+            return a.key < k;
+        });
+        if (pos != end && pos->key == key) return false;
+
+        if (m_size == m_capacity) {
+            const auto index = pos - m_data;
+            grow(storage);
+            pos = m_data + index;
+        }
+        std::memmove(pos + 1, pos, (m_data + m_size - pos) * sizeof(attribute));
+
+        pos->key  = key;
+        pos->type = &value_ops_of<value_type>;
+        if constexpr (fits_inline<value_type>) {
+            ::new (pos->payload) value_type(std::forward<T>(value));
+        } else {
+            void* out_of_line = storage.create<value_type>(std::forward<T>(value));
+            std::memcpy(pos->payload, &out_of_line, sizeof(out_of_line));
+        }
+        ++m_size;
+        return true;
+    }
+
+    /**
+     * @brief Copies every attribute into a new block backed by storage. Out of line values which are not
+     * copy constructible are left out.
+     */
+    [[nodiscard]] auto clone(arena& storage) const -> attribute_block
+    {
+        attribute_block copy;
+        if (m_size == 0) return copy;
+
+        copy.m_data     = storage.allocate_array<attribute>(m_size);
+        copy.m_capacity = m_size;
+        for (const attribute& a : *this) {
+            attribute& target = copy.m_data[copy.m_size];
+            std::memcpy(&target, &a, sizeof(attribute));
+            if (!a.type->stored_inline) {
+                if (!a.type->clone) continue;
+                void* out_of_line = a.type->clone(storage, a.out_of_line());
+                std::memcpy(target.payload, &out_of_line, sizeof(out_of_line));
+            }
+            ++copy.m_size;
+        }
+        return copy;
+    }
+
+    /**
+     * @brief Returns the attribute stored under key, or nullptr if there is none.
+     */
+    [[nodiscard]] auto find(const uint64_t key) const noexcept -> const attribute*
+    {
+        const attribute* const begin = m_data;
+        const attribute* const end   = m_data + m_size;
+        const attribute* pos         = std::lower_bound(begin, end, key, [](const attribute& a, const uint64_t k) {
+            return a.key < k;
+        });
+        return pos != end && pos->key == key ? pos : nullptr;
+    }
+
+    [[nodiscard]] auto begin() const noexcept -> const attribute* { return m_data; }
+    [[nodiscard]] auto end() const noexcept -> const attribute* { return m_data + m_size; }
+    [[nodiscard]] auto size() const noexcept -> size_t { return m_size; }
+    [[nodiscard]] auto empty() const noexcept -> bool { return m_size == 0; }
+
+private:
+    auto grow(arena& storage) -> void
+    {
+        const uint32_t capacity = m_capacity ? m_capacity * 2 : 2;
+        attribute* data         = storage.allocate_array<attribute>(capacity);
+        if (m_size) std::memcpy(data, m_data, m_size * sizeof(attribute));
+        // the old array is simply abandoned, it is released together with the arena
+        m_data     = data;
+        m_capacity = capacity;
+    }
+
+    auto destroy() noexcept -> void
+    {
+        for (const attribute& a : *this) {
+            if (!a.type->stored_inline && a.type->destroy) a.type->destroy(a.out_of_line());
+        }
+        m_data = nullptr;
+        m_size = m_capacity = 0;
+    }
+
+    attribute* m_data   = nullptr;
+    uint32_t m_size     = 0;
+    uint32_t m_capacity = 0;
+};
+} // namespace reflex::internal
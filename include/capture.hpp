@@ -1,7 +1,22 @@
 #pragma once
 
-#include "traits.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include "alias.hpp"
+#include "context.hpp"
+#include "exception.hpp"
+#include "meta.hpp"
+#include "thunk.hpp"
+#include "traits.hpp"
+#include "type_name.hpp"
 
 
 namespace reflex
@@ -10,39 +25,303 @@ template <typename T>
 class reflector
 {
 public:
-    reflector(context* ctx, const hashed_string& hash) : m_ctx(ctx), m_type_hash(hash)
+    reflector(context* ctx, const hashed_string& hash) :
+        m_ctx(ctx), m_type_hash(hash),
+        m_desc(ctx->emplace(hash, internal::type_descriptor{ { }, sizeof(T), { } }, internal::alias<T>::index.load()).first) { }
+
+    /**
+     * @brief Captures a field. Member fields are recorded by their offset, static fields by their address so
+     * they can be accessed without any instance, see field_handle::is_static(). A name this type already
+     * has keeps its field, like in base(), and decorate() then attaches to that one.
+     * @throws reflection_error if field_name hashes like a different field of this type.
+     */
+    template <auto Ptr>
+        requires field_ptr<Ptr>
+    auto field(const char* field_name) -> reflector&
+    {
+        const auto lock                  = m_ctx->lock_storage();
+        internal::arena& storage         = m_ctx->storage();
+        internal::string_interner& names = m_ctx->names();
+        const hashed_string hash{ field_name };
+
+        if constexpr (static_field_ptr<Ptr>) {
+            using field_type = std::remove_pointer_t<decltype(Ptr)>;
+
+            check_collision(m_desc->static_names, m_desc->statics, &internal::field_descriptor::field_hash, hash);
+            m_last_static = true;
+            m_last_field  = m_desc->static_names.find(hash.value());
+            if (m_last_field != internal::field_index::npos) return *this;
+
+            const interned_string name = names.intern(hash);
+            m_last_field               = static_cast<uint32_t>(m_desc->statics.size());
+            m_desc->static_names.insert(storage, name.value(), m_last_field);
+            m_desc->statics.emplace_back(
+                    storage,
+                    name,
+                    names.intern(internal::alias<std::remove_cv_t<field_type>>::hash()),
+                    0,
+                    sizeof(field_type),
+                    std::is_trivially_copyable_v<field_type>,
+                    internal::attribute_block{ },
+                    const_cast<void*>(static_cast<const volatile void*>(Ptr)));
+            return *this;
+        } else {
+            using field_type = member_info<decltype(Ptr)>::field_type;
+            using class_type = member_info<decltype(Ptr)>::class_type;
+
+            // god
+            const size_t offset = reinterpret_cast<size_t>(&(((class_type*)0)->*Ptr));
+
+            check_collision(m_desc->field_names, m_desc->fields, &internal::field_descriptor::field_hash, hash);
+            m_last_static = false;
+            m_last_field  = m_desc->field_names.find(hash.value());
+            if (m_last_field != internal::field_index::npos) return *this;
+
+            const interned_string name = names.intern(hash);
+            m_last_field               = static_cast<uint32_t>(m_desc->fields.size());
+            m_desc->field_names.insert(storage, name.value(), m_last_field);
+            m_desc->fields.emplace_back(
+                    storage,
+                    name,
+                    names.intern(internal::alias<field_type>::hash()),
+                    offset,
+                    sizeof(field_type),
+                    std::is_trivially_copyable_v<field_type>,
+                    internal::attribute_block{ });
+            m_ctx->invalidate_layouts();
+            return *this;
+        }
+    }
+
+    /**
+     * @brief Inherits the fields of the base class B, which must have been captured into the same context first.
+     *
+     * The fields of B, including those B inherited itself, are copied into this type with their offsets
+     * shifted to the B subobject, so walking the fields of a derived type never walks the hierarchy. Fields
+     * whose name this type already has keep their field, and fields captured on B later are not picked up.
+     * Static fields of B are inherited the same way. Only non virtual bases are supported.
+     * @throws reflection_error if B has not been captured into this context.
+     */
+    template <typename B>
+        requires std::is_base_of_v<B, T> && (!std::is_same_v<B, T>)
+    auto base() -> reflector&
     {
-        ctx->emplace(hash, internal::type_descriptor{ hash, sizeof(T), { } });
+        // any suitably aligned address works, a null pointer would stay null through the conversion
+        const auto* derived = reinterpret_cast<const T*>(uintptr_t{ 0x10000 });
+        const size_t offset = reinterpret_cast<const std::byte*>(static_cast<const B*>(derived)) -
+                              reinterpret_cast<const std::byte*>(derived);
+
+        const uint32_t index                       = internal::alias<B>::index.load(std::memory_order_acquire);
+        const internal::type_descriptor* inherited = m_ctx->find(index);
+        if (!inherited) throw reflection_error{ "Attempted to inherit from a base that has not been captured." };
+
+        constexpr auto name_of_field = &internal::field_descriptor::field_hash;
+        const auto lock              = m_ctx->lock_storage();
+        internal::arena& storage     = m_ctx->storage();
+        m_desc->fields.reserve(storage, m_desc->fields.size() + inherited->fields.size());
+        for (const internal::field_descriptor& field : inherited->statics) {
+            check_collision(m_desc->static_names, m_desc->statics, name_of_field, field.field_hash);
+            const uint64_t key = field.field_hash.value();
+            if (m_desc->static_names.find(key) != internal::field_index::npos) continue;
+            m_desc->static_names.insert(storage, key, static_cast<uint32_t>(m_desc->statics.size()));
+            m_desc->statics.emplace_back(
+                    storage,
+                    field.field_hash,
+                    field.type_hash,
+                    0,
+                    field.size,
+                    field.trivially_copyable,
+                    field.attributes.clone(storage),
+                    field.address);
+        }
+        for (const internal::field_descriptor& field : inherited->fields) {
+            check_collision(m_desc->field_names, m_desc->fields, name_of_field, field.field_hash);
+            const uint32_t index = static_cast<uint32_t>(m_desc->fields.size());
+            // a field of this type shadows the one of B, which would be unreachable by name
+            if (!m_desc->field_names.insert(storage, field.field_hash.value(), index)) continue;
+            m_desc->fields.emplace_back(
+                    storage,
+                    field.field_hash,
+                    field.type_hash,
+                    offset + field.offset,
+                    field.size,
+                    field.trivially_copyable,
+                    field.attributes.clone(storage));
+        }
+
+        add_ancestor(storage, internal::base_descriptor{ inherited->hash, offset });
+        for (const internal::base_descriptor& ancestor : inherited->ancestors) {
+            add_ancestor(storage, internal::base_descriptor{ ancestor.hash, offset + ancestor.offset });
+        }
+        std::ranges::sort(m_desc->ancestors, { }, [](const internal::base_descriptor& b) { return b.hash.value(); });
+        m_ctx->invalidate_layouts();
+        return *this;
     }
 
+    /**
+     * @brief Captures a member function, invoked later through a method_handle.
+     *
+     * The call is erased into a trampoline generated for Ptr, a plain function pointer, so neither capturing
+     * nor invoking allocates. The return and argument types are recorded by the hash of their names.
+     * @throws reflection_error if method_name hashes like a different method of this type.
+     */
     template <auto Ptr>
-        requires field_ptr<Ptr>
-    auto field(const char* field_name) noexcept -> reflector&
+        requires member_function_ptr<Ptr>
+    auto method(const char* method_name) -> reflector&
     {
-        auto& ctx        = *m_ctx;
-        using field_type = member_info<decltype(Ptr)>::field_type;
-        using class_type = member_info<decltype(Ptr)>::class_type;
+        using info = method_info<decltype(Ptr)>;
 
-        // god
-        const size_t offset = reinterpret_cast<size_t>(&(((class_type*)0)->*Ptr));
+        const auto lock                  = m_ctx->lock_storage();
+        internal::arena& storage         = m_ctx->storage();
+        internal::string_interner& names = m_ctx->names();
+        const hashed_string hash{ method_name };
+        check_collision(m_desc->method_names, m_desc->methods, &internal::method_descriptor::method_hash, hash);
+        const interned_string name = names.intern(hash);
+        m_desc->method_names.insert(storage, name.value(), static_cast<uint32_t>(m_desc->methods.size()));
 
-        internal::type_descriptor& desc = ctx.at(m_type_hash);
-        desc.fields.emplace_back(hashed_string{ field_name }, internal::alias<field_type>::hash, offset, std::unordered_map<hashed_string, std::any>{ });
+        internal::arena_array<interned_string> arguments;
+        [&]<typename... Args>(std::type_identity<std::tuple<Args...>>) {
+            arguments.reserve(storage, sizeof...(Args));
+            (arguments.emplace_back(storage, names.intern(internal::alias<std::remove_cvref_t<Args>>::hash())), ...);
+        }(std::type_identity<typename info::arguments>{ });
 
+        m_desc->methods.emplace_back(
+                storage,
+                name,
+                names.intern(internal::alias<std::remove_cvref_t<typename info::return_type>>::hash()),
+                std::move(arguments),
+                info::is_const,
+                &internal::thunk<Ptr>);
         return *this;
     }
 
-    auto decorate(const char* key, std::any val) -> reflector&
+    /**
+     * @brief Captures every field listed in the compile time meta<T> specialization, see meta.hpp.
+     */
+    auto from_meta() -> reflector&
+        requires has_meta<T>
+    {
+        std::apply(
+                [this]<typename... Fields>(const Fields&... fields) {
+                    (this->template field<Fields::pointer>(fields.name), ...);
+                },
+                meta<T>::fields);
+        return *this;
+    }
+
+    /**
+     * @brief Attaches an attribute to the most recently captured field, static or not. Keys already present
+     * are ignored.
+     * @param key The name of the attribute.
+     * @param val The value, small trivially copyable values are stored inline without any allocation.
+     */
+    template <typename V>
+    auto decorate(const char* key, V&& val) -> reflector&
     {
         // todo: kinda strange idk, maybe child struct instead with ref to parent? or pass decorate args direct to field()?
-        auto& ctx                       = *m_ctx;
-        internal::type_descriptor& desc = ctx.at(m_type_hash);
-        desc.fields.back().attributes.emplace(hashed_string{ key }, val);
+        const auto lock = m_ctx->lock_storage();
+        auto& decorated = m_last_static ? m_desc->statics[m_last_field] : m_desc->fields[m_last_field];
+        decorated.attributes.emplace(m_ctx->storage(), hashed_string{ key }.value(), std::forward<V>(val));
+        // the field table mirrors attributes
+        m_ctx->invalidate_layouts();
         return *this;
     }
 
 private:
+    /**
+     * @brief Throws if name shares its hash with a different name already in captured, the index would
+     * otherwise silently resolve both names to the first one.
+     */
+    template <typename Descriptor>
+    static auto check_collision(
+            const internal::field_index& index,
+            const internal::arena_array<Descriptor>& captured,
+            interned_string Descriptor::*key,
+            const hashed_string& name) -> void
+    {
+        const uint32_t existing = index.find(name.value());
+        if (existing == internal::field_index::npos) return;
+
+        const interned_string& other = captured[existing].*key;
+        if (other.same_string(name)) return;
+
+        constexpr std::string_view collides = "' collides with the hash of '";
+        std::string message;
+        message.reserve(name.length() + other.length() + collides.size() + 3);
+        message.append(1, '\'').append(name.data(), name.length()).append(collides);
+        message.append(other.data(), other.length()).append("'.");
+        throw reflection_error{ message };
+    }
+
+    /// @brief Records base unless it is already known, through another path of a diamond the first one wins.
+    auto add_ancestor(internal::arena& storage, const internal::base_descriptor& base) -> void
+    {
+        const auto known = [&](const internal::base_descriptor& b) { return b.hash == base.hash; };
+        if (!std::ranges::any_of(m_desc->ancestors, known)) m_desc->ancestors.emplace_back(storage, base);
+    }
+
     context* m_ctx;
     const hashed_string m_type_hash;
+    internal::type_descriptor* m_desc;
+    /// @brief The most recently captured field and whether it is static, so decorate() knows which one to
+    /// attach to.
+    uint32_t m_last_field = internal::field_index::npos;
+    bool m_last_static    = false;
+};
+
+/**
+ * @brief Captures the enumerators of E, see capture_enum().
+ *
+ * Enumerators are added to the value and name tables of E in one go per call, so listing them all in a
+ * single values<...>() call builds the tables once.
+ */
+template <typename E>
+    requires std::is_enum_v<E>
+class enum_reflector
+{
+public:
+    enum_reflector(context* ctx, const hashed_string& hash) :
+        m_ctx(ctx),
+        m_desc(ctx->emplace(
+                hash, internal::type_descriptor{ { }, sizeof(E), { } }, internal::alias<E>::index.load()).first)
+    {
+        const auto lock = m_ctx->lock_storage();
+        if (!m_desc->enumerators) m_desc->enumerators = std::make_unique<internal::enum_table>();
+    }
+
+    /**
+     * @brief Adds every enumerator of Values under the name the compiler spells it with, e.g. "green" for
+     * color::green. The names and their hashes are computed at compile time.
+     */
+    template <E... Values>
+    auto values() -> enum_reflector&
+    {
+        static_assert(((internal::value_name_view<Values>().size() != 0) && ...), "reflex: Values must name enumerators.");
+        static constexpr internal::enum_table::enumerator enumerators[] = {
+            { hashed_string{ internal::value_name<Values>() }, underlying(Values) }...,
+        };
+        const auto lock = m_ctx->lock_storage();
+        m_desc->enumerators->add(enumerators);
+        return *this;
+    }
+
+    /**
+     * @brief Adds value under name. Names already taken are ignored.
+     */
+    auto value(const E value, const char* name) -> enum_reflector&
+    {
+        const auto lock = m_ctx->lock_storage();
+        m_desc->enumerators->add(m_ctx->names().intern(hashed_string{ name }), underlying(value));
+        return *this;
+    }
+
+private:
+    static constexpr auto underlying(const E value) noexcept -> int64_t
+    {
+        return static_cast<int64_t>(static_cast<std::underlying_type_t<E>>(value));
+    }
+
+    context* m_ctx;
+    internal::type_descriptor* m_desc;
 };
 } // namespace reflex
@@ -1,17 +1,536 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <unordered_map>
-#include "hashed_string.hpp"
+#include <utility>
+#include <vector>
+#include "alias.hpp"
+#include "arena.hpp"
+#include "copy_plan.hpp"
+#include "dense_index.hpp"
 #include "descriptor.hpp"
+#include "exception.hpp"
+#include "field_table.hpp"
+#include "flat_table.hpp"
+#include "hashed_string.hpp"
+#include "perfect_hash.hpp"
+#include "string_interner.hpp"
 
 // todo: capture primitives? otherwise reflector wont work
 
 namespace reflex
 {
-// todo: user ptrs here? in case of realloc
-/// @brief A Storage container for reflected types.
-using context = std::unordered_map<hashed_string, internal::type_descriptor>;
+namespace internal
+{
+/**
+ * @brief One shard of a context, owning the descriptors whose hash falls into it.
+ */
+struct alignas(64) context_shard
+{
+    context_shard() = default;
+
+    context_shard(const context_shard&)                    = delete;
+    auto operator=(const context_shard&) -> context_shard& = delete;
+
+    /// @brief The descriptors live in the context arena, which outlives the shards.
+    ~context_shard()
+    {
+        index.for_each([](uint64_t, type_descriptor* desc) {
+            while (desc) {
+                type_descriptor* next = desc->collision;
+                desc->~type_descriptor();
+                desc = next;
+            }
+        });
+    }
+
+    mutable std::shared_mutex mutex;
+    /// @brief Maps hashed type names to their descriptor, which is owned by the shard.
+    flat_table<type_descriptor*> index;
+    /// @brief The number of descriptors chained behind another one with the same hash, see type_descriptor.
+    size_t collisions = 0;
+};
+} // namespace internal
+
+
+/**
+ * @brief Memory statistics of a context, see context::stats().
+ */
+struct context_stats
+{
+    /// @brief Allocations served by the arena, each of which would otherwise have been a heap allocation.
+    size_t allocations;
+    /// @brief Bytes handed out by the arena, excluding alignment padding.
+    size_t bytes;
+    /// @brief Chunks the arena obtained from the heap, the only heap allocations made for the above.
+    size_t chunks;
+    /// @brief The total size of all chunks.
+    size_t bytes_reserved;
+    /// @brief Distinct names interned, every type, field and method sharing a name shares its copy.
+    size_t names;
+    /// @brief Bytes taken by interned names, kept apart from the arena above.
+    size_t name_bytes;
+};
+
+
+/**
+ * @brief A Storage container for reflected types.
+ *
+ * Descriptors, their field arrays and attributes are bump allocated from an arena owned by the context and
+ * released with it in one go. Names are copied once into the string interner of the context on capture, so
+ * they never dangle however they were built, and are shared by every descriptor spelling them the same.
+ * Descriptors never move once allocated and are indexed by flat_table's keyed on hashed_string::value(), so
+ * pointers handed out to type_handle's stay valid while more types are captured. Once registration is done
+ * the context can be frozen, see freeze().
+ *
+ * Two names whose hashes collide are told apart by comparing the names, the type captured second is chained
+ * behind the first one. Lookups only compare names in a shard where a hash has actually collided, every other
+ * lookup remains a single integer compare which never touches the descriptor.
+ *
+ * The index is split into shards selected by the high bits of the hash, each guarded by its own reader
+ * writer lock, so types can be captured and looked up from many threads at once without contending on a
+ * single mutex. Lookups through the dense type index take no lock at all. Copy plans and the field table
+ * may be asked for while other threads capture fields, they read the descriptors under the storage lock.
+ * Handles walking the fields of a type directly are not synchronized with captures into that same type,
+ * capture a type fully before handing it to other threads.
+ */
+class context
+{
+public:
+    context() : m_shards(std::make_unique<internal::context_shard[]>(shard_count)) { }
+
+    context(const context&)                    = delete;
+    auto operator=(const context&) -> context& = delete;
+
+    /**
+     * @brief Moves every type out of other, which may only be assigned to or destroyed afterwards.
+     * Not synchronized, no other thread may use either context meanwhile.
+     */
+    context(context&& other) noexcept :
+        m_arena(std::move(other.m_arena)),
+        m_names(std::move(other.m_names)),
+        m_shards(std::move(other.m_shards)),
+        m_dense(std::move(other.m_dense)),
+        m_layout_version(other.m_layout_version.load(std::memory_order_relaxed)),
+        m_plans(std::move(other.m_plans)),
+        m_field_tables(std::move(other.m_field_tables)),
+        m_field_table(std::exchange(other.m_field_table, nullptr)),
+        m_field_table_version(other.m_field_table_version),
+        m_frozen(other.m_frozen),
+        m_packed(std::move(other.m_packed)),
+        m_packed_keys(std::move(other.m_packed_keys)),
+        m_perfect(std::move(other.m_perfect)) { }
+
+    auto operator=(context&& other) noexcept -> context&
+    {
+        if (this == &other) return *this;
+        // descriptors may point into the arena, release them before it
+        m_shards         = std::move(other.m_shards);
+        m_packed         = std::move(other.m_packed);
+        m_arena          = std::move(other.m_arena);
+        m_names          = std::move(other.m_names);
+        m_dense          = std::move(other.m_dense);
+        m_layout_version = other.m_layout_version.load(std::memory_order_relaxed);
+        m_plans          = std::move(other.m_plans);
+        m_field_tables   = std::move(other.m_field_tables);
+        // a frozen context never rebuilds its table, so it has to come along
+        m_field_table         = std::exchange(other.m_field_table, nullptr);
+        m_field_table_version = other.m_field_table_version;
+        m_frozen              = other.m_frozen;
+        m_packed_keys    = std::move(other.m_packed_keys);
+        m_perfect        = std::move(other.m_perfect);
+        return *this;
+    }
+
+    /**
+     * @brief Stores desc under hash unless a type with the same name has already been captured. A type whose
+     * name merely shares the hash is stored as well, see type_descriptor::collision.
+     * @param desc The descriptor to store, its name is replaced by hash interned into names().
+     * @param index The dense index of the type (see internal::alias), allowing find(uint32_t) to reach it.
+     * @return The stored descriptor and whether the insertion took place.
+     */
+    auto emplace(
+            const hashed_string& hash,
+            internal::type_descriptor desc,
+            const uint32_t index = internal::invalid_index) -> std::pair<internal::type_descriptor*, bool>
+    {
+        if (m_frozen) throw reflection_error{ "Attempted to capture into a frozen context." };
+
+        internal::context_shard& shard = shard_of(hash.value());
+        internal::type_descriptor* stored;
+        {
+            const std::unique_lock lock{ shard.mutex };
+            internal::type_descriptor* last = nullptr;
+            if (internal::type_descriptor* const* existing = shard.index.find(hash.value())) {
+                for (internal::type_descriptor* same = *existing; same; same = same->collision) {
+                    if (same->hash.same_string(hash)) return { same, false };
+                    last = same;
+                }
+            }
+
+            const std::scoped_lock storage{ m_storage_mutex };
+            desc.hash = m_names.intern(hash);
+            stored    = m_arena.create<internal::type_descriptor>(std::move(desc));
+            if (last) {
+                last->collision = stored;
+                ++shard.collisions;
+            } else {
+                shard.index.emplace(hash.value(), stored);
+            }
+        }
+
+        invalidate_layouts();
+        if (index != internal::invalid_index) m_dense.store(index, stored);
+        return { stored, true };
+    }
+
+    /**
+     * @brief Returns the descriptor stored under hash, or nullptr if it has not been captured.
+     */
+    [[nodiscard]] auto find(const hashed_string& hash) noexcept -> internal::type_descriptor*
+    {
+        return const_cast<internal::type_descriptor*>(std::as_const(*this).find(hash));
+    }
+
+    [[nodiscard]] auto find(const hashed_string& hash) const noexcept -> const internal::type_descriptor*
+    {
+        if (m_frozen) {
+            if (m_packed.empty()) return nullptr;
+            const size_t slot = m_perfect(hash.value());
+            if (m_packed_keys[slot] != hash.value()) return nullptr;
+            // chained descriptors are packed after the slotted ones, so the sizes only differ after a collision
+            return m_packed.size() != m_packed_keys.size() ? resolve(&m_packed[slot], hash) : &m_packed[slot];
+        }
+        const internal::context_shard& shard = shard_of(hash.value());
+        const std::shared_lock lock{ shard.mutex };
+        internal::type_descriptor* const* desc = shard.index.find(hash.value());
+        if (!desc) return nullptr;
+        return shard.collisions ? resolve(*desc, hash) : *desc;
+    }
+
+    /**
+     * @brief Returns the descriptor captured with the dense type index, or nullptr if there is none.
+     */
+    [[nodiscard]] auto find(const uint32_t index) const noexcept -> const internal::type_descriptor*
+    {
+        return m_dense.find(index);
+    }
+
+    /**
+     * @brief Returns the descriptor stored under hash.
+     * @throws reflection_error if no type has been captured under hash.
+     */
+    [[nodiscard]] auto at(const hashed_string& hash) -> internal::type_descriptor&
+    {
+        return const_cast<internal::type_descriptor&>(std::as_const(*this).at(hash));
+    }
+
+    [[nodiscard]] auto at(const hashed_string& hash) const -> const internal::type_descriptor&
+    {
+        const internal::type_descriptor* desc = find(hash);
+        if (!desc) throw reflection_error{ "Attempted to access type that has not been captured." };
+        return *desc;
+    }
+
+    [[nodiscard]] auto contains(const hashed_string& hash) const noexcept -> bool { return find(hash) != nullptr; }
+
+    /**
+     * @brief Returns the copy plan of desc, computing and caching it on first use.
+     *
+     * Plans recurse into field types captured in this context, so they are invalidated whenever the layout
+     * of any type changes, see invalidate_layouts(). Frozen contexts compute every plan up front. A stale
+     * plan is replaced rather than rebuilt in place, so the returned plan stays valid and unchanged for as
+     * long as the context, even while another thread captures types and asks for the new one.
+     */
+    [[nodiscard]] auto plan_of(const internal::type_descriptor& desc) const -> const copy_plan&
+    {
+        if (m_frozen) return *desc.plan;
+
+        const std::scoped_lock lock{ m_plan_mutex };
+        if (desc.plan_version != m_layout_version.load(std::memory_order_acquire)) build_plan(desc);
+        return *desc.plan;
+    }
+
+    /**
+     * @brief Returns the columnar mirror of every field captured in this context, rebuilding it on first use
+     * after any type, field or attribute has been added. Frozen contexts build it up front. Like plans,
+     * tables are replaced rather than rebuilt in place, the returned one stays valid as long as the context.
+     */
+    [[nodiscard]] auto field_table() const -> const reflex::field_table&
+    {
+        if (m_frozen) return *m_field_table;
+
+        const std::scoped_lock lock{ m_plan_mutex };
+        if (m_field_table_version != m_layout_version.load(std::memory_order_acquire)) build_field_table();
+        return *m_field_table;
+    }
+
+    /**
+     * @brief Discards every cached copy plan and the field table, called whenever fields or attributes are
+     * added to a captured type.
+     */
+    auto invalidate_layouts() noexcept -> void { m_layout_version.fetch_add(1, std::memory_order_acq_rel); }
+
+    /**
+     * @brief Reserves space for count types so capturing them does not rehash the index.
+     */
+    auto reserve(const size_t count) -> void
+    {
+        for (size_t i = 0; i < shard_count; ++i) {
+            const std::unique_lock lock{ m_shards[i].mutex };
+            m_shards[i].index.reserve(count / shard_count + 1);
+        }
+    }
+
+    /**
+     * @brief Makes the context read only and rebuilds it for the fastest possible lookups.
+     *
+     * All descriptors are packed into one contiguous array ordered by a minimal perfect hash over their
+     * hashes, so a lookup evaluates the hash and compares a single key. A frozen context is never mutated
+     * again, which makes concurrent lookups from any number of threads safe without any locking.
+     *
+     * Freezing relocates every descriptor, handles and reflectors obtained before the call are invalidated.
+     * It must not run concurrently with any other use of the context.
+     * @throws reflection_error on any later attempt to capture into this context.
+     */
+    auto freeze() -> void
+    {
+        if (m_frozen) return;
+
+        std::vector<uint64_t> keys;
+        std::vector<internal::type_descriptor*> chained;
+        keys.reserve(size());
+        for_each_shard([&](const internal::context_shard& shard) {
+            shard.index.for_each([&](const uint64_t key, internal::type_descriptor* desc) {
+                keys.push_back(key);
+                for (internal::type_descriptor* next = desc->collision; next; next = next->collision) {
+                    chained.push_back(next);
+                }
+            });
+        });
+        m_perfect = internal::perfect_hash{ keys };
+
+        std::vector<internal::type_descriptor*> by_slot(keys.size());
+        for_each_shard([&](const internal::context_shard& shard) {
+            shard.index.for_each([&](const uint64_t key, internal::type_descriptor* desc) {
+                by_slot[m_perfect(key)] = desc;
+            });
+        });
+        // descriptors chained behind a colliding hash have no slot, they follow the slots and stay chained
+        by_slot.insert(by_slot.end(), chained.begin(), chained.end());
+        std::unordered_map<const internal::type_descriptor*, size_t> packed_index;
+        for (size_t i = 0; i < by_slot.size(); ++i) packed_index.emplace(by_slot[i], i);
+
+        m_packed.reserve(m_arena, by_slot.size());
+        m_packed_keys.reserve(m_arena, keys.size());
+        for (size_t i = 0; i < keys.size(); ++i) m_packed_keys.emplace_back(m_arena, by_slot[i]->hash.value());
+        // the dense index still points at the shards, repoint it before the descriptors move out of them
+        m_dense.for_each([&](internal::type_descriptor*& desc) { desc = m_packed.data() + packed_index.at(desc); });
+        for (internal::type_descriptor* desc : by_slot) {
+            internal::type_descriptor& packed = m_packed.emplace_back(m_arena, std::move(*desc));
+            if (packed.collision) packed.collision = m_packed.data() + packed_index.at(packed.collision);
+        }
+
+        m_shards = std::make_unique<internal::context_shard[]>(shard_count);
+        m_frozen = true;
+
+        // lookups must never write once frozen, so everything cached lazily is built now
+        invalidate_layouts();
+        for (const internal::type_descriptor& desc : m_packed) build_plan(desc);
+        build_field_table();
+    }
+
+    [[nodiscard]] auto frozen() const noexcept -> bool { return m_frozen; }
+
+    /**
+     * @brief The arena backing descriptors, field arrays, names and attribute values, freed with the context.
+     */
+    [[nodiscard]] auto storage() noexcept -> internal::arena& { return m_arena; }
+
+    /**
+     * @brief The interner owning every name captured into the context, see interned_string.
+     */
+    [[nodiscard]] auto names() noexcept -> internal::string_interner& { return m_names; }
+
+    /**
+     * @brief Must be held while allocating from storage() or interning into names() when other threads may
+     * capture into the context.
+     */
+    [[nodiscard]] auto lock_storage() const -> std::unique_lock<std::mutex> { return std::unique_lock{ m_storage_mutex }; }
+
+    /**
+     * @brief Reports how much memory the arena has handed out.
+     */
+    [[nodiscard]] auto stats() const -> context_stats
+    {
+        const std::scoped_lock lock{ m_storage_mutex };
+        return context_stats{
+            m_arena.allocations(),
+            m_arena.bytes_allocated(),
+            m_arena.chunks(),
+            m_arena.bytes_reserved(),
+            m_names.size(),
+            m_names.bytes(),
+        };
+    }
+
+    [[nodiscard]] auto size() const noexcept -> size_t
+    {
+        if (m_frozen) return m_packed.size();
+        size_t count = 0;
+        for_each_shard([&](const internal::context_shard& shard) {
+            const std::shared_lock lock{ shard.mutex };
+            count += shard.index.size() + shard.collisions;
+        });
+        return count;
+    }
+
+    [[nodiscard]] auto empty() const noexcept -> bool { return size() == 0; }
+
+private:
+    static constexpr size_t shard_bits  = 4;
+    static constexpr size_t shard_count = size_t{ 1 } << shard_bits;
+
+    [[nodiscard]] auto shard_of(const uint64_t key) const noexcept -> internal::context_shard&
+    {
+        return m_shards[key >> (64 - shard_bits)];
+    }
+
+    /**
+     * @brief Finds the type named like hash among those chained behind first, whose hashes all collide.
+     */
+    [[nodiscard]] static auto resolve(const internal::type_descriptor* first, const hashed_string& hash) noexcept
+            -> const internal::type_descriptor*
+    {
+        for (const internal::type_descriptor* desc = first; desc; desc = desc->collision) {
+            if (desc->hash.same_string(hash)) return desc;
+        }
+        return nullptr;
+    }
+
+    template <typename Fn>
+    auto for_each_shard(Fn&& fn) const -> void
+    {
+        for (size_t i = 0; i < shard_count; ++i) fn(m_shards[i]);
+    }
+
+    auto build_field_table() const -> void
+    {
+        // read before the descriptors, a capture racing with the rebuild then leaves the table stale
+        const uint64_t version = m_layout_version.load(std::memory_order_acquire);
+        std::vector<const internal::type_descriptor*> types;
+        if (m_frozen) {
+            for (const internal::type_descriptor& desc : m_packed) types.push_back(&desc);
+        } else {
+            for_each_shard([&](const internal::context_shard& shard) {
+                const std::shared_lock lock{ shard.mutex };
+                shard.index.for_each([&](uint64_t, const internal::type_descriptor* desc) {
+                    for (; desc; desc = desc->collision) types.push_back(desc);
+                });
+            });
+        }
+        auto table = std::make_unique<reflex::field_table>();
+        {
+            // taken after the shard locks, emplace() nests the storage lock inside a shard lock
+            const std::scoped_lock storage{ m_storage_mutex };
+            table->rebuild(types);
+        }
+        m_field_table         = m_field_tables.emplace_back(std::move(table)).get();
+        m_field_table_version = version;
+    }
+
+    auto build_plan(const internal::type_descriptor& desc) const -> void
+    {
+        // read before the fields, a capture racing with the build then leaves the plan stale
+        const uint64_t version = m_layout_version.load(std::memory_order_acquire);
+        auto plan              = std::make_unique<copy_plan>();
+        append_runs(planned_fields(desc), 0, *plan);
+        desc.plan         = m_plans.emplace_back(std::move(plan)).get();
+        desc.plan_version = version;
+    }
+
+    /// @brief What a copy plan needs of a field, copied out of the descriptor, see planned_fields().
+    struct planned_field
+    {
+        interned_string type_hash;
+        size_t offset;
+        size_t size;
+        bool trivially_copyable;
+    };
+
+    /**
+     * @brief Copies the fields of desc under the storage lock they are captured under. find() takes the
+     * shard locks, which emplace() holds while taking the storage lock, so nested types are only looked up
+     * once it is released again.
+     */
+    auto planned_fields(const internal::type_descriptor& desc) const -> std::vector<planned_field>
+    {
+        const std::scoped_lock storage{ m_storage_mutex };
+        std::vector<planned_field> fields;
+        fields.reserve(desc.fields.size());
+        for (const internal::field_descriptor& field : desc.fields) {
+            fields.push_back(planned_field{ field.type_hash, field.offset, field.size, field.trivially_copyable });
+        }
+        return fields;
+    }
+
+    auto append_runs(const std::vector<planned_field>& fields, const size_t base, copy_plan& plan) const -> void
+    {
+        for (const planned_field& field : fields) {
+            const size_t offset = base + field.offset;
+
+            if (const internal::type_descriptor* nested = find(field.type_hash)) {
+                const std::vector<planned_field> nested_fields = planned_fields(*nested);
+                if (!nested_fields.empty()) {
+                    append_runs(nested_fields, offset, plan);
+                    continue;
+                }
+            }
+            if (!field.trivially_copyable) {
+                plan.complete = false;
+                continue;
+            }
+
+            if (!plan.runs.empty() && plan.runs.back().offset + plan.runs.back().size == offset) {
+                plan.runs.back().size += field.size;
+            } else {
+                plan.runs.push_back(copy_run{ offset, field.size });
+            }
+            plan.bytes += field.size;
+        }
+    }
+
+    /// @brief Declared first so it outlives every descriptor pointing into it.
+    internal::arena m_arena;
+    /// @brief Declared before the shards for the same reason.
+    internal::string_interner m_names;
+    mutable std::mutex m_storage_mutex;
+    /// @brief Owns every captured descriptor until the context is frozen.
+    std::unique_ptr<internal::context_shard[]> m_shards;
+    /// @brief Maps dense type indices to their descriptor, nullptr for types not captured here.
+    internal::dense_index<internal::type_descriptor> m_dense;
+
+    /// @brief Bumped on every layout change, cached copy plans and field tables from older versions are stale.
+    std::atomic<uint64_t> m_layout_version = 1;
+    /// @brief Serializes building copy plans and the field table, which readers cache lazily.
+    mutable std::mutex m_plan_mutex;
+    /// @brief Every plan and field table built so far. Readers may still hold stale ones, so they are only
+    /// released with the context, layouts rarely change once types are being read.
+    mutable std::vector<std::unique_ptr<const copy_plan>> m_plans;
+    mutable std::vector<std::unique_ptr<const reflex::field_table>> m_field_tables;
+    /// @brief The most recent of m_field_tables.
+    mutable const reflex::field_table* m_field_table = nullptr;
+    mutable uint64_t m_field_table_version = 0;
+    bool m_frozen = false;
+    /// @brief Once frozen, every descriptor ordered by its slot in m_perfect, followed by chained collisions.
+    internal::arena_array<internal::type_descriptor> m_packed;
+    /// @brief The hash of each descriptor with a slot, kept apart so misses never touch a descriptor.
+    internal::arena_array<uint64_t> m_packed_keys;
+    internal::perfect_hash m_perfect;
+};
 
 
 namespace internal
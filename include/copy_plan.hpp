@@ -0,0 +1,43 @@
+/**
+ * @file copy_plan.hpp
+ * @brief Precomputed memcpy runs covering the trivially copyable bytes of a captured type.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+
+namespace reflex
+{
+/// @brief A contiguous byte range of an object which can be copied with a single memcpy.
+struct copy_run
+{
+    size_t offset;
+    size_t size;
+};
+
+/**
+ * @brief The maximal contiguous byte ranges of a type covered by trivially copyable fields, recursing into
+ * captured field types. Padding between fields is never part of a run.
+ */
+struct copy_plan
+{
+    std::vector<copy_run> runs{ };
+    /// @brief The sum of all run sizes, the size of an object once packed.
+    size_t bytes = 0;
+    /// @brief Whether every field is covered, false if some field is neither captured nor trivially copyable.
+    bool complete = true;
+
+    /**
+     * @brief Copies every run from src to dst, both pointing at objects of the planned type.
+     */
+    auto copy(void* dst, const void* src) const noexcept -> void
+    {
+        auto* out      = static_cast<std::byte*>(dst);
+        const auto* in = static_cast<const std::byte*>(src);
+        for (const copy_run& run : runs) std::memcpy(out + run.offset, in + run.offset, run.size);
+    }
+};
+} // namespace reflex
@@ -0,0 +1,120 @@
+/**
+ * @file dense_index.hpp
+ * @brief A grow only array of pointers indexed by dense type indices, readable without locking.
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+
+namespace reflex::internal
+{
+/**
+ * @brief Maps small integer indices to pointers.
+ *
+ * Storage is split into chunks of doubling size which are never moved once allocated, so growing the
+ * index never invalidates a concurrent reader. Reads are two acquire loads, writers race only on
+ * allocating a chunk which is resolved by a compare exchange.
+ */
+template <typename T>
+class dense_index
+{
+public:
+    dense_index() = default;
+
+    dense_index(const dense_index&)                    = delete;
+    auto operator=(const dense_index&) -> dense_index& = delete;
+
+    dense_index(dense_index&& other) noexcept { swap(other); }
+
+    auto operator=(dense_index&& other) noexcept -> dense_index&
+    {
+        dense_index{ std::move(other) }.swap(*this);
+        return *this;
+    }
+
+    ~dense_index()
+    {
+        for (auto& chunk : m_chunks) delete[] chunk.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Returns the pointer stored at index, or nullptr if none has been.
+     */
+    [[nodiscard]] auto find(const uint32_t index) const noexcept -> T*
+    {
+        const auto [chunk, slot]     = locate(index);
+        const std::atomic<T*>* slots = m_chunks[chunk].load(std::memory_order_acquire);
+        return slots ? slots[slot].load(std::memory_order_acquire) : nullptr;
+    }
+
+    /**
+     * @brief Stores value at index, overwriting any previous value.
+     */
+    auto store(const uint32_t index, T* value) -> void
+    {
+        const auto [chunk, slot] = locate(index);
+        std::atomic<T*>* slots   = m_chunks[chunk].load(std::memory_order_acquire);
+        if (!slots) {
+            auto* fresh = new std::atomic<T*>[chunk_size(chunk)]{ };
+            if (m_chunks[chunk].compare_exchange_strong(slots, fresh, std::memory_order_acq_rel)) {
+                slots = fresh;
+            } else {
+                delete[] fresh;
+            }
+        }
+        slots[slot].store(value, std::memory_order_release);
+    }
+
+    /**
+     * @brief Calls fn(value) with a reference to every non null value, allowing them to be repointed.
+     */
+    template <typename Fn>
+    auto for_each(Fn&& fn) -> void
+    {
+        for (size_t chunk = 0; chunk < chunk_count; ++chunk) {
+            std::atomic<T*>* slots = m_chunks[chunk].load(std::memory_order_acquire);
+            if (!slots) continue;
+            for (size_t i = 0; i < chunk_size(chunk); ++i) {
+                T* value = slots[i].load(std::memory_order_relaxed);
+                if (!value) continue;
+                fn(value);
+                slots[i].store(value, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    auto swap(dense_index& other) noexcept -> void
+    {
+        for (size_t i = 0; i < chunk_count; ++i) {
+            m_chunks[i].store(other.m_chunks[i].exchange(m_chunks[i].load(std::memory_order_relaxed)));
+        }
+    }
+
+private:
+    static constexpr size_t first_chunk_bits = 6;
+    /// @brief Enough chunks to address every uint32_t index.
+    static constexpr size_t chunk_count = 32 - first_chunk_bits + 1;
+
+    static constexpr auto chunk_size(const size_t chunk) noexcept -> size_t
+    {
+        return size_t{ 1 } << (chunk + first_chunk_bits);
+    }
+
+    /// @brief Chunk k holds the indices [(2^k - 1) * 64, (2^(k+1) - 1) * 64).
+    static constexpr auto locate(const uint32_t index) noexcept -> std::pair<size_t, size_t>
+    {
+        const uint64_t biased = (uint64_t{ index } >> first_chunk_bits) + 1;
+        const size_t chunk    = std::bit_width(biased) - 1;
+        const uint64_t base   = ((uint64_t{ 1 } << chunk) - 1) << first_chunk_bits;
+        return { chunk, static_cast<size_t>(index - base) };
+    }
+
+    std::array<std::atomic<std::atomic<T*>*>, chunk_count> m_chunks{ };
+};
+} // namespace reflex::internal
@@ -1,7 +1,14 @@
 #pragma once
 
-#include <vector>
-#include <any>
+#include <memory>
+#include "arena.hpp"
+#include "attribute.hpp"
+#include "copy_plan.hpp"
+#include "enum_table.hpp"
+#include "field_index.hpp"
+#include "hashed_string.hpp"
+#include "string_interner.hpp"
+#include "thunk.hpp"
 
 
 namespace reflex::internal
@@ -9,20 +16,58 @@ namespace reflex::internal
 
 struct field_descriptor
 {
-    hashed_string field_hash;
-    hashed_string type_hash;
+    interned_string field_hash;
+    interned_string type_hash;
+    size_t offset;
+    size_t size;
+    bool trivially_copyable;
+    attribute_block attributes; //< Additional user defined meta data, useful for GUI's.
+    /// @brief The absolute address of a static field, which has no offset, or nullptr for a member field.
+    void* address = nullptr;
+};
+
+struct method_descriptor
+{
+    interned_string method_hash;
+    interned_string return_hash;
+    arena_array<interned_string> argument_hashes;
+    /// @brief Whether the method may be called on a const object.
+    bool is_const;
+    method_thunk thunk;
+};
+
+struct base_descriptor
+{
+    interned_string hash;
+    /// @brief The offset of the base class subobject from the start of the derived object.
     size_t offset;
-    // todo: do we acc need a map here?
-    std::unordered_map<hashed_string, std::any> attributes; //< Additional user defined meta data, useful for GUI's.
 };
 
 struct type_descriptor
 {
-    hashed_string hash;
+    /// @brief Interned by context::emplace(), whatever the descriptor passed to it holds.
+    interned_string hash;
     size_t size;
-    std::vector<field_descriptor> fields{ };
-    // std::vector<hashed_string> funcs{ };
-    // std::vector<hashed_string> bases{ };
+    /// @brief Own and inherited fields in capture order, inherited ones already at their offset within this type.
+    arena_array<field_descriptor> fields{ };
+    /// @brief Finds fields by the hash of their name, filled as fields are captured.
+    field_index field_names{ };
+    /// @brief Static fields, kept apart so nothing walking the layout of an instance ever sees them.
+    arena_array<field_descriptor> statics{ };
+    field_index static_names{ };
+    arena_array<method_descriptor> methods{ };
+    /// @brief Finds methods by the hash of their name, filled as methods are captured.
+    field_index method_names{ };
+    /// @brief Every direct and indirect base class, sorted by hash so is_a never walks the hierarchy.
+    arena_array<base_descriptor> ancestors{ };
+    /// @brief The enumerators of an enum captured through capture_enum(), null for every other type.
+    std::unique_ptr<enum_table> enumerators{ };
+    /// @brief The next type whose name hashes to the same value, told apart by comparing names. Only the first
+    /// type of such a chain is indexed by its hash.
+    type_descriptor* collision = nullptr;
+    /// @brief Owned and cached by the context, current while plan_version matches the context layout version.
+    mutable const copy_plan* plan = nullptr;
+    mutable uint64_t plan_version = 0;
 };
 
 }
@@ -0,0 +1,167 @@
+/**
+ * @file enum_table.hpp
+ * @brief Constant time conversions between the enumerators of a captured enum and their names.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+#include "hashed_string.hpp"
+#include "hash.hpp"
+#include "perfect_hash.hpp"
+
+
+namespace reflex::internal
+{
+/**
+ * @brief The enumerators of one enum, indexed both ways.
+ *
+ * Values map to names through a dense array spanning the smallest to the largest value, as long as the
+ * values are not spread too thinly over it, and through a binary search over the sorted values otherwise.
+ * Names map to values through a minimal perfect hash over the name hashes, confirmed by one string compare
+ * so a string which merely shares a hash is never converted. Both tables are rebuilt whenever an enumerator
+ * is added, conversions never allocate.
+ */
+class enum_table
+{
+public:
+    static constexpr uint32_t npos = UINT32_MAX;
+
+    struct enumerator
+    {
+        hashed_string name;
+        /// @brief The underlying value, unsigned values beyond the signed range wrap around.
+        int64_t value;
+    };
+
+    /**
+     * @brief Adds an enumerator unless name is already taken. Several names may share a value, converting
+     * the value yields the name added first.
+     * @return Whether the enumerator has been added.
+     */
+    auto add(const hashed_string& name, const int64_t value) -> bool
+    {
+        const enumerator added[] = { { name, value } };
+        return add(added) != 0;
+    }
+
+    /**
+     * @brief Adds every enumerator whose name is not taken yet, rebuilding the tables only once.
+     * @return The number of enumerators added.
+     */
+    auto add(const std::span<const enumerator> enumerators) -> size_t
+    {
+        const size_t before = m_entries.size();
+        for (const enumerator& e : enumerators) {
+            const auto same_name = [&](const enumerator& other) { return other.name == e.name; };
+            const bool taken     = find({ e.name.data(), e.name.length() }) ||
+                               std::ranges::any_of(m_entries.begin() + before, m_entries.end(), same_name);
+            if (!taken) {
+                m_entries.push_back(e);
+            }
+        }
+        if (m_entries.size() != before) rebuild();
+        return m_entries.size() - before;
+    }
+
+    /**
+     * @brief Returns the name of value, or nullptr if no enumerator has it.
+     */
+    [[nodiscard]] auto name_of(const int64_t value) const noexcept -> const char*
+    {
+        uint32_t index = npos;
+        if (!m_dense.empty()) {
+            // wraps around for values below the minimum, so a single compare rejects both sides
+            const uint64_t slot = static_cast<uint64_t>(value) - static_cast<uint64_t>(m_min);
+            if (slot < m_dense.size()) index = m_dense[slot];
+        } else {
+            const auto it = std::ranges::lower_bound(m_by_value, value, { }, [&](const uint32_t i) {
+                return m_entries[i].value;
+            });
+            if (it != m_by_value.end() && m_entries[*it].value == value) index = *it;
+        }
+        return index == npos ? nullptr : m_entries[index].name.data();
+    }
+
+    /**
+     * @brief Returns the enumerator called name, or nullptr if there is none.
+     */
+    [[nodiscard]] auto find(const std::string_view name) const noexcept -> const enumerator*
+    {
+        // the slots only cover the enumerators present at the last rebuild, add() probes before rebuilding
+        if (m_slot_keys.empty()) return nullptr;
+        const uint64_t key = hashed_string::hasher::hash(name.data(), name.size());
+        const size_t slot  = m_perfect(key);
+        if (m_slot_keys[slot] != key) return nullptr;
+        const enumerator& e = m_entries[m_by_slot[slot]];
+        return e.name.length() == name.size() && equal(e.name.data(), name.data(), name.size()) ? &e : nullptr;
+    }
+
+    [[nodiscard]] auto entries() const noexcept -> std::span<const enumerator> { return m_entries; }
+    [[nodiscard]] auto size() const noexcept -> size_t { return m_entries.size(); }
+    /// @brief Whether values are converted through the dense array rather than a binary search.
+    [[nodiscard]] auto dense() const noexcept -> bool { return !m_dense.empty(); }
+
+private:
+    /**
+     * @brief Compares size bytes a word at a time, which keeps the branches on the size predictable where a
+     * call to memcmp would not be.
+     */
+    static auto equal(const char* a, const char* b, const size_t size) noexcept -> bool
+    {
+        if (size >= 8) {
+            for (size_t i = 0; i + 8 < size; i += 8) {
+                if (read<8>(a + i) != read<8>(b + i)) return false;
+            }
+            return read<8>(a + size - 8) == read<8>(b + size - 8);
+        }
+        if (size >= 4) return ((read<4>(a) ^ read<4>(b)) | (read<4>(a + size - 4) ^ read<4>(b + size - 4))) == 0;
+        // a size below 4 is covered by its first, middle and last byte
+        return size == 0 || (a[0] == b[0] && a[size / 2] == b[size / 2] && a[size - 1] == b[size - 1]);
+    }
+
+    auto rebuild() -> void
+    {
+        const auto by_value = [&](const uint32_t i) { return m_entries[i].value; };
+        m_by_value.resize(m_entries.size());
+        for (uint32_t i = 0; i < m_by_value.size(); ++i) m_by_value[i] = i;
+        // stable, so the first enumerator of a value comes first
+        std::ranges::stable_sort(m_by_value, { }, by_value);
+
+        m_min               = m_entries[m_by_value.front()].value;
+        const uint64_t span = static_cast<uint64_t>(m_entries[m_by_value.back()].value) - static_cast<uint64_t>(m_min);
+        m_dense.clear();
+        // flags and other sparse enums fall back to the binary search instead of wasting memory
+        if (span < m_entries.size() * 4 + 64) {
+            m_dense.assign(span + 1, npos);
+            for (auto it = m_by_value.rbegin(); it != m_by_value.rend(); ++it) {
+                m_dense[static_cast<uint64_t>(m_entries[*it].value) - static_cast<uint64_t>(m_min)] = *it;
+            }
+        }
+
+        std::vector<uint64_t> keys;
+        for (const enumerator& e : m_entries) keys.push_back(e.name.value());
+        m_perfect = perfect_hash{ keys };
+        m_slot_keys.assign(m_entries.size(), 0);
+        m_by_slot.assign(m_entries.size(), npos);
+        for (uint32_t i = 0; i < m_entries.size(); ++i) {
+            const size_t slot = m_perfect(keys[i]);
+            m_slot_keys[slot] = keys[i];
+            m_by_slot[slot]   = i;
+        }
+    }
+
+    std::vector<enumerator> m_entries;
+    /// @brief Indices into m_entries ordered by value.
+    std::vector<uint32_t> m_by_value;
+    /// @brief The index of the enumerator of each value from m_min on, empty if the values are too sparse.
+    std::vector<uint32_t> m_dense;
+    int64_t m_min = 0;
+    perfect_hash m_perfect;
+    std::vector<uint64_t> m_slot_keys;
+    std::vector<uint32_t> m_by_slot;
+};
+} // namespace reflex::internal
@@ -0,0 +1,209 @@
+/**
+ * @file epoch.hpp
+ * @brief Epoch based reclamation, deferring the destruction of shared objects until no reader can see them.
+ */
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+
+namespace reflex::internal
+{
+/**
+ * @brief A process wide epoch domain.
+ *
+ * Every thread owns a record announcing the epoch it entered a read side section in. Entering and leaving
+ * is a store to that record, so readers never wait on each other or on writers. Writers unpublish an
+ * object and retire it, tagging it with the current epoch, and it is destroyed once every active reader
+ * has entered in a later epoch, at which point none of them can still hold it.
+ */
+class epoch_domain
+{
+public:
+    static constexpr uint64_t quiescent = UINT64_MAX;
+
+    struct alignas(64) record
+    {
+        std::atomic<uint64_t> epoch{ quiescent };
+        std::atomic<bool> in_use{ true };
+        /// @brief Nesting depth of the owning thread's read side sections, only touched by that thread.
+        uint32_t depth = 0;
+        record* next   = nullptr;
+    };
+
+    epoch_domain() = default;
+
+    epoch_domain(const epoch_domain&)                    = delete;
+    auto operator=(const epoch_domain&) -> epoch_domain& = delete;
+
+    ~epoch_domain()
+    {
+        for (const retired& item : m_retired) item.destroy(item.object);
+        for (record* r = m_records.load(); r;) delete std::exchange(r, r->next);
+    }
+
+    [[nodiscard]] static auto instance() -> epoch_domain&
+    {
+        static epoch_domain domain;
+        return domain;
+    }
+
+    /**
+     * @brief The record of the calling thread, claimed on first use and released when the thread exits.
+     */
+    [[nodiscard]] auto local() -> record&
+    {
+        thread_local owner current{ };
+        if (!current.claimed) current.claimed = acquire();
+        return *current.claimed;
+    }
+
+    auto enter(record& r) noexcept -> void
+    {
+        if (r.depth++ != 0) return;
+        r.epoch.store(m_epoch.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        // the announcement must be visible before any shared pointer is read
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
+    auto leave(record& r) noexcept -> void
+    {
+        if (--r.depth == 0) r.epoch.store(quiescent, std::memory_order_release);
+    }
+
+    /**
+     * @brief Destroys object with destroy once no reader can reach it. It must already be unpublished.
+     */
+    auto retire(void* object, void (*destroy)(void*)) -> void
+    {
+        {
+            const std::scoped_lock lock{ m_mutex };
+            m_retired.push_back(retired{ object, destroy, m_epoch.fetch_add(1, std::memory_order_seq_cst) });
+        }
+        reclaim();
+    }
+
+    /**
+     * @brief Destroys every retired object no active reader can still see.
+     */
+    auto reclaim() -> void
+    {
+        std::vector<retired> ready;
+        {
+            const std::scoped_lock lock{ m_mutex };
+            const uint64_t oldest = oldest_active();
+            std::erase_if(m_retired, [&](const retired& item) {
+                if (item.epoch >= oldest) return false;
+                ready.push_back(item);
+                return true;
+            });
+        }
+        for (const retired& item : ready) item.destroy(item.object);
+    }
+
+    /// @brief The number of retired objects still waiting for readers to move on.
+    [[nodiscard]] auto pending() const -> size_t
+    {
+        const std::scoped_lock lock{ m_mutex };
+        return m_retired.size();
+    }
+
+private:
+    struct retired
+    {
+        void* object;
+        void (*destroy)(void*);
+        uint64_t epoch;
+    };
+
+    /// @brief Releases the record of a thread when it exits.
+    struct owner
+    {
+        ~owner()
+        {
+            if (!claimed) return;
+            claimed->depth = 0;
+            claimed->epoch.store(quiescent, std::memory_order_release);
+            claimed->in_use.store(false, std::memory_order_release);
+        }
+
+        record* claimed = nullptr;
+    };
+
+    auto acquire() -> record*
+    {
+        for (record* r = m_records.load(std::memory_order_acquire); r; r = r->next) {
+            bool expected = false;
+            if (r->in_use.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) return r;
+        }
+        auto* fresh = new record{ };
+        fresh->next = m_records.load(std::memory_order_relaxed);
+        while (!m_records.compare_exchange_weak(fresh->next, fresh, std::memory_order_acq_rel)) { }
+        return fresh;
+    }
+
+    [[nodiscard]] auto oldest_active() const noexcept -> uint64_t
+    {
+        uint64_t oldest = quiescent;
+        for (const record* r = m_records.load(std::memory_order_acquire); r; r = r->next) {
+            oldest = std::min(oldest, r->epoch.load(std::memory_order_seq_cst));
+        }
+        return oldest;
+    }
+
+    std::atomic<uint64_t> m_epoch{ 0 };
+    std::atomic<record*> m_records{ nullptr };
+    mutable std::mutex m_mutex;
+    std::vector<retired> m_retired;
+};
+
+/**
+ * @brief Keeps the calling thread inside a read side section of the epoch domain while alive.
+ *
+ * Copies nest on the same thread record. A guard must be destroyed on the thread which created it, so
+ * objects holding one are not to be handed to other threads. A default constructed guard pins nothing.
+ */
+class epoch_guard
+{
+public:
+    epoch_guard() = default;
+
+    [[nodiscard]] static auto pin() -> epoch_guard
+    {
+        epoch_domain& domain = epoch_domain::instance();
+        epoch_domain::record& record = domain.local();
+        domain.enter(record);
+        return epoch_guard{ &record };
+    }
+
+    epoch_guard(const epoch_guard& other) noexcept : m_record(other.m_record)
+    {
+        if (m_record) ++m_record->depth;
+    }
+
+    epoch_guard(epoch_guard&& other) noexcept : m_record(std::exchange(other.m_record, nullptr)) { }
+
+    auto operator=(epoch_guard other) noexcept -> epoch_guard&
+    {
+        std::swap(m_record, other.m_record);
+        return *this;
+    }
+
+    ~epoch_guard()
+    {
+        if (m_record) epoch_domain::instance().leave(*m_record);
+    }
+
+    [[nodiscard]] auto pinned() const noexcept -> bool { return m_record != nullptr; }
+
+private:
+    explicit epoch_guard(epoch_domain::record* record) noexcept : m_record(record) { }
+
+    epoch_domain::record* m_record = nullptr;
+};
+} // namespace reflex::internal
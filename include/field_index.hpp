@@ -0,0 +1,161 @@
+/**
+ * @file field_index.hpp
+ * @brief Maps the name hashes of a type's fields to their position, for lookups by name.
+ */
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include "arena.hpp"
+
+
+namespace reflex::internal
+{
+/**
+ * @brief A per-type index from field name hashes to field indices, maintained as fields are captured.
+ *
+ * Entries are kept sorted by hash and searched without branching on the comparisons, which for the handful
+ * of fields most types have beats any hashing. Past small_limit fields an open addressing table is built
+ * next to the sorted entries, so lookups stay a single probe on average however large a type grows. All
+ * storage is bump allocated from the owning context's arena.
+ */
+class field_index
+{
+public:
+    static constexpr uint32_t npos = UINT32_MAX;
+    /// @brief Types with more fields than this are also indexed by the hash table.
+    static constexpr uint32_t small_limit = 8;
+
+    field_index() = default;
+
+    field_index(const field_index&)                    = delete;
+    auto operator=(const field_index&) -> field_index& = delete;
+
+    field_index(field_index&& other) noexcept { swap(other); }
+
+    auto operator=(field_index&& other) noexcept -> field_index&
+    {
+        field_index{ std::move(other) }.swap(*this);
+        return *this;
+    }
+
+    auto swap(field_index& other) noexcept -> void
+    {
+        std::swap(m_entries, other.m_entries);
+        std::swap(m_slots, other.m_slots);
+        std::swap(m_size, other.m_size);
+        std::swap(m_capacity, other.m_capacity);
+        std::swap(m_slot_mask, other.m_slot_mask);
+    }
+
+    /**
+     * @brief Indexes the field at index under key unless key is already present, the first field captured
+     * under a name keeps it.
+     * @return Whether the entry has been stored.
+     */
+    auto insert(arena& storage, const uint64_t key, const uint32_t index) -> bool
+    {
+        entry* const end = m_entries + m_size;
+        entry* pos       = std::lower_bound(m_entries, end, key, [](const entry& e, const uint64_t k) {
+            return e.key < k;
+        });
+        if (pos != end && pos->key == key) return false;
+
+        if (m_size == m_capacity) {
+            const auto offset = pos - m_entries;
+            grow(storage);
+            pos = m_entries + offset;
+        }
+        std::memmove(pos + 1, pos, (m_entries + m_size - pos) * sizeof(entry));
+        *pos = entry{ key, index };
+        ++m_size;
+
+        if (m_size > small_limit) {
+            // keep the table at most half full
+            if (m_size * 2 > m_slot_mask + 1) {
+                rehash(storage, std::bit_ceil(m_size * 4));
+            } else {
+                place(key, index);
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Returns the index of the field named key, or npos if there is none.
+     */
+    [[nodiscard]] auto find(const uint64_t key) const noexcept -> uint32_t
+    {
+        if (m_slots) {
+            for (size_t pos = mix(key) & m_slot_mask;; pos = (pos + 1) & m_slot_mask) {
+                const entry& slot = m_slots[pos];
+                if (slot.key == key && slot.index != npos) return slot.index;
+                if (slot.index == npos) return npos;
+            }
+        }
+        if (m_size == 0) return npos;
+
+        // lands on the last entry not greater than key, the compare compiles to a conditional move
+        const entry* base = m_entries;
+        for (size_t n = m_size; n > 1;) {
+            const size_t half = n / 2;
+            base              = base[half].key <= key ? base + half : base;
+            n -= half;
+        }
+        return base->key == key ? base->index : npos;
+    }
+
+    [[nodiscard]] auto size() const noexcept -> size_t { return m_size; }
+    [[nodiscard]] auto empty() const noexcept -> bool { return m_size == 0; }
+    /// @brief Whether lookups go through the hash table rather than the sorted entries.
+    [[nodiscard]] auto hashed() const noexcept -> bool { return m_slots != nullptr; }
+
+private:
+    struct entry
+    {
+        uint64_t key;
+        uint32_t index;
+    };
+
+    // Keys are hashes already, a Fibonacci multiply spreads their entropy before masking.
+    [[nodiscard]] static constexpr auto mix(const uint64_t key) noexcept -> uint64_t
+    {
+        return (key * 0x9E3779B97F4A7C15ull) >> 32;
+    }
+
+    auto grow(arena& storage) -> void
+    {
+        const uint32_t capacity = m_capacity ? m_capacity * 2 : 4;
+        entry* entries          = storage.allocate_array<entry>(capacity);
+        if (m_size) std::memcpy(entries, m_entries, m_size * sizeof(entry));
+        // the old array is simply abandoned, it is released together with the arena
+        m_entries  = entries;
+        m_capacity = capacity;
+    }
+
+    auto rehash(arena& storage, const size_t slot_count) -> void
+    {
+        m_slots     = storage.allocate_array<entry>(slot_count);
+        m_slot_mask = slot_count - 1;
+        std::fill_n(m_slots, slot_count, entry{ 0, npos });
+        for (uint32_t i = 0; i < m_size; ++i) place(m_entries[i].key, m_entries[i].index);
+    }
+
+    auto place(const uint64_t key, const uint32_t index) noexcept -> void
+    {
+        size_t pos = mix(key) & m_slot_mask;
+        while (m_slots[pos].index != npos) pos = (pos + 1) & m_slot_mask;
+        m_slots[pos] = entry{ key, index };
+    }
+
+    entry* m_entries    = nullptr;
+    entry* m_slots      = nullptr;
+    uint32_t m_size     = 0;
+    uint32_t m_capacity = 0;
+    size_t m_slot_mask  = 0;
+};
+} // namespace reflex::internal
@@ -0,0 +1,229 @@
+/**
+ * @file field_table.hpp
+ * @brief A columnar mirror of every captured field, for scans across all types of a context.
+ */
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "alias.hpp"
+#include "descriptor.hpp"
+#include "hashed_string.hpp"
+
+
+namespace reflex
+{
+/**
+ * @brief Selects the rows of a field_table, every criterion left out matches all fields.
+ */
+class field_filter
+{
+public:
+    /// @brief Matches fields whose type has been captured or deduced under type.
+    auto of_type(const hashed_string& type) noexcept -> field_filter&
+    {
+        m_type = type.value();
+        return *this;
+    }
+
+    /// @brief Matches fields of type T.
+    template <typename T>
+    auto of_type() noexcept -> field_filter& { return of_type(internal::alias<T>::hash()); }
+
+    auto named(const hashed_string& name) noexcept -> field_filter&
+    {
+        m_name = name.value();
+        return *this;
+    }
+
+    /// @brief Matches fields decorated with key, may be given several times to require every key.
+    auto with_attribute(const hashed_string& key) -> field_filter&
+    {
+        m_attributes.push_back(key.value());
+        return *this;
+    }
+
+private:
+    friend class field_table;
+
+    uint64_t m_type = 0;
+    uint64_t m_name = 0;
+    std::vector<uint64_t> m_attributes;
+};
+
+/**
+ * @brief Every field of a context laid out as parallel columns, one row per field.
+ *
+ * A filtered scan only streams through the 8 byte columns it tests, 64 rows at a time into a bitmask of
+ * matches, instead of touching whole field_descriptor's spread over the heap. The first 63 distinct
+ * attribute keys each own a bit of the attribute mask column, the last bit flags fields carrying any
+ * further key, which are then verified against their descriptor.
+ *
+ * Owned and kept up to date by a context, see context::field_table().
+ */
+class field_table
+{
+public:
+    static constexpr uint32_t no_bit = UINT32_MAX;
+    /// @brief Set for fields carrying an attribute key beyond the first 63.
+    static constexpr uint32_t overflow_bit = 63;
+
+    /**
+     * @brief Replaces the contents with the fields of every type in types.
+     */
+    auto rebuild(const std::span<const internal::type_descriptor* const> types) -> void
+    {
+        clear();
+        m_types.assign(types.begin(), types.end());
+        for (uint32_t owner = 0; owner < m_types.size(); ++owner) {
+            for (const internal::field_descriptor& field : m_types[owner]->fields) {
+                uint64_t mask = 0;
+                for (const internal::attribute& attr : field.attributes) mask |= uint64_t{ 1 } << claim_bit(attr.key);
+
+                m_name_hashes.push_back(field.field_hash.value());
+                m_type_hashes.push_back(field.type_hash.value());
+                m_attribute_masks.push_back(mask);
+                m_offsets.push_back(static_cast<uint32_t>(field.offset));
+                m_owners.push_back(owner);
+                m_fields.push_back(&field);
+            }
+        }
+    }
+
+    /**
+     * @brief Calls fn(row) for every row matching filter, in row order.
+     */
+    template <typename Fn>
+    auto for_each(const field_filter& filter, Fn&& fn) const -> void
+    {
+        uint64_t required = 0;
+        bool verify       = false;
+        for (const uint64_t key : filter.m_attributes) {
+            const uint32_t bit = bit_of(key);
+            // no field carries the key at all
+            if (bit == no_bit) return;
+            verify |= bit == overflow_bit;
+            required |= uint64_t{ 1 } << bit;
+        }
+
+        const size_t rows = size();
+        for (size_t base = 0; base < rows; base += 64) {
+            const size_t block = std::min<size_t>(64, rows - base);
+            uint64_t matches   = match_block(base, block, filter.m_type, filter.m_name, required);
+            for (; matches; matches &= matches - 1) {
+                const size_t row = base + std::countr_zero(matches);
+                if (verify && !has_attributes(row, filter)) continue;
+                fn(row);
+            }
+        }
+    }
+
+    /// @brief The number of rows matching filter.
+    [[nodiscard]] auto count(const field_filter& filter) const -> size_t
+    {
+        size_t matches = 0;
+        for_each(filter, [&](size_t) { ++matches; });
+        return matches;
+    }
+
+    [[nodiscard]] auto name_hashes() const noexcept -> std::span<const uint64_t> { return m_name_hashes; }
+    [[nodiscard]] auto type_hashes() const noexcept -> std::span<const uint64_t> { return m_type_hashes; }
+    [[nodiscard]] auto attribute_masks() const noexcept -> std::span<const uint64_t> { return m_attribute_masks; }
+    [[nodiscard]] auto offsets() const noexcept -> std::span<const uint32_t> { return m_offsets; }
+    /// @brief The index of the type owning each row, see owner().
+    [[nodiscard]] auto owners() const noexcept -> std::span<const uint32_t> { return m_owners; }
+
+    [[nodiscard]] auto field(const size_t row) const noexcept -> const internal::field_descriptor*
+    {
+        return m_fields[row];
+    }
+
+    [[nodiscard]] auto owner(const size_t row) const noexcept -> const internal::type_descriptor*
+    {
+        return m_types[m_owners[row]];
+    }
+
+    /// @brief The bit representing key in the attribute mask column, no_bit if no field carries key.
+    [[nodiscard]] auto bit_of(const uint64_t key) const noexcept -> uint32_t
+    {
+        const auto it = std::ranges::find(m_attribute_keys, key);
+        if (it != m_attribute_keys.end()) return static_cast<uint32_t>(it - m_attribute_keys.begin());
+        return std::ranges::find(m_overflow_keys, key) != m_overflow_keys.end() ? overflow_bit : no_bit;
+    }
+
+    [[nodiscard]] auto size() const noexcept -> size_t { return m_fields.size(); }
+    [[nodiscard]] auto empty() const noexcept -> bool { return m_fields.empty(); }
+
+private:
+    auto clear() -> void
+    {
+        m_name_hashes.clear();
+        m_type_hashes.clear();
+        m_attribute_masks.clear();
+        m_offsets.clear();
+        m_owners.clear();
+        m_fields.clear();
+        m_types.clear();
+        m_attribute_keys.clear();
+        m_overflow_keys.clear();
+    }
+
+    auto claim_bit(const uint64_t key) -> uint32_t
+    {
+        if (const uint32_t bit = bit_of(key); bit != no_bit) return bit;
+        if (m_attribute_keys.size() < overflow_bit) {
+            m_attribute_keys.push_back(key);
+            return static_cast<uint32_t>(m_attribute_keys.size() - 1);
+        }
+        m_overflow_keys.push_back(key);
+        return overflow_bit;
+    }
+
+    /// @brief A bitmask of the rows [base, base + block) matching, branch free so the compares can be vectorized.
+    [[nodiscard]] auto match_block(
+            const size_t base,
+            const size_t block,
+            const uint64_t type,
+            const uint64_t name,
+            const uint64_t required) const noexcept -> uint64_t
+    {
+        const uint64_t* types = m_type_hashes.data() + base;
+        const uint64_t* names = m_name_hashes.data() + base;
+        const uint64_t* masks = m_attribute_masks.data() + base;
+
+        // an unset criterion masks its compare away
+        const uint64_t type_mask = type ? ~uint64_t{ 0 } : 0;
+        const uint64_t name_mask = name ? ~uint64_t{ 0 } : 0;
+
+        uint64_t matches = 0;
+        for (size_t i = block; i-- > 0;) {
+            const uint64_t miss = ((types[i] ^ type) & type_mask) | ((names[i] ^ name) & name_mask) |
+                                  ((masks[i] & required) ^ required);
+            matches = (matches << 1) | uint64_t{ miss == 0 };
+        }
+        return matches;
+    }
+
+    [[nodiscard]] auto has_attributes(const size_t row, const field_filter& filter) const noexcept -> bool
+    {
+        return std::ranges::all_of(filter.m_attributes, [&](const uint64_t key) {
+            return m_fields[row]->attributes.find(key) != nullptr;
+        });
+    }
+
+    std::vector<uint64_t> m_name_hashes;
+    std::vector<uint64_t> m_type_hashes;
+    std::vector<uint64_t> m_attribute_masks;
+    std::vector<uint32_t> m_offsets;
+    std::vector<uint32_t> m_owners;
+    std::vector<const internal::field_descriptor*> m_fields;
+    std::vector<const internal::type_descriptor*> m_types;
+    /// @brief The key owning each bit of the attribute mask column.
+    std::vector<uint64_t> m_attribute_keys;
+    std::vector<uint64_t> m_overflow_keys;
+};
+} // namespace reflex
@@ -0,0 +1,225 @@
+/**
+ * @file flat_table.hpp
+ * @brief An open addressing hash table keyed by precomputed 64-bit hashes.
+ */
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define REFLEX_HAS_SSE2 1
+#include <emmintrin.h>
+#else
+#define REFLEX_HAS_SSE2 0
+#endif
+
+
+namespace reflex::internal
+{
+/**
+ * @brief A SwissTable style flat hash map from a precomputed 64-bit hash to a trivially copyable value.
+ *
+ * Every slot has a one byte control entry, either empty or holding 7 bits of the key's hash. Lookups load
+ * a group of 16 control bytes at once and only compare full keys for the slots whose 7 bit tag matches,
+ * so a probe usually touches a single cache line of control bytes and a single slot. Keys are already
+ * hashes (see hashed_string::value()) so they are only remixed, never rehashed from the string.
+ *
+ * Entries can never be erased, which keeps probing free of tombstones. Values are stored inline and are
+ * moved on growth, so store pointers or indices into stable storage rather than large objects.
+ */
+template <typename T>
+class flat_table
+{
+public:
+    static constexpr size_t group_width = 16;
+
+    flat_table() = default;
+
+    flat_table(const flat_table&)                    = delete;
+    auto operator=(const flat_table&) -> flat_table& = delete;
+
+    flat_table(flat_table&& other) noexcept { swap(other); }
+
+    auto operator=(flat_table&& other) noexcept -> flat_table&
+    {
+        flat_table{ std::move(other) }.swap(*this);
+        return *this;
+    }
+
+    /**
+     * @brief Returns a pointer to the value stored for key, or nullptr if there is none.
+     */
+    [[nodiscard]] auto find(const uint64_t key) const noexcept -> const T*
+    {
+        if (m_size == 0) return nullptr;
+
+        const uint64_t mixed = mix(key);
+        const uint8_t tag    = h2(mixed);
+        size_t pos           = h1(mixed);
+        for (size_t stride = group_width;; stride += group_width) {
+            const group g{ m_ctrl.get() + pos };
+            for (uint32_t mask = g.match(tag); mask; mask &= mask - 1) {
+                const size_t index = (pos + std::countr_zero(mask)) & m_mask;
+                if (m_slots[index].key == key) return &m_slots[index].value;
+            }
+            if (g.match_empty()) return nullptr;
+            pos = (pos + stride) & m_mask;
+        }
+    }
+
+    [[nodiscard]] auto find(const uint64_t key) noexcept -> T*
+    {
+        return const_cast<T*>(std::as_const(*this).find(key));
+    }
+
+    /**
+     * @brief Inserts value under key if key is not present yet.
+     * @return A pointer to the stored value and whether the insertion took place.
+     */
+    auto emplace(const uint64_t key, const T& value) -> std::pair<T*, bool>
+    {
+        if (T* existing = find(key)) return { existing, false };
+
+        if ((m_size + 1) * 8 > m_capacity * 7) grow();
+        T* stored = insert_unique(key, value);
+        ++m_size;
+        return { stored, true };
+    }
+
+    /**
+     * @brief Reserves space for at least count entries without further growth.
+     */
+    auto reserve(const size_t count) -> void
+    {
+        size_t capacity = group_width;
+        while (count * 8 > capacity * 7) capacity *= 2;
+        if (capacity > m_capacity) rehash(capacity);
+    }
+
+    /**
+     * @brief Calls fn(key, value) for every stored entry, in unspecified order.
+     */
+    template <typename Fn>
+    auto for_each(Fn&& fn) const -> void
+    {
+        for (size_t i = 0; i < m_capacity; ++i) {
+            if (!is_empty(m_ctrl[i])) fn(m_slots[i].key, m_slots[i].value);
+        }
+    }
+
+    [[nodiscard]] auto size() const noexcept -> size_t { return m_size; }
+    [[nodiscard]] auto capacity() const noexcept -> size_t { return m_capacity; }
+    [[nodiscard]] auto empty() const noexcept -> bool { return m_size == 0; }
+
+    auto swap(flat_table& other) noexcept -> void
+    {
+        std::swap(m_ctrl, other.m_ctrl);
+        std::swap(m_slots, other.m_slots);
+        std::swap(m_capacity, other.m_capacity);
+        std::swap(m_mask, other.m_mask);
+        std::swap(m_shift, other.m_shift);
+        std::swap(m_size, other.m_size);
+    }
+
+private:
+    static constexpr uint8_t empty_ctrl = 0x80;
+
+    struct slot
+    {
+        uint64_t key;
+        T value;
+    };
+
+    /// @brief A view of group_width consecutive control bytes.
+    struct group
+    {
+#if REFLEX_HAS_SSE2
+        explicit group(const uint8_t* ctrl) : bytes(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl))) { }
+
+        [[nodiscard]] auto match(const uint8_t tag) const noexcept -> uint32_t
+        {
+            return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(static_cast<char>(tag)))));
+        }
+
+        [[nodiscard]] auto match_empty() const noexcept -> uint32_t
+        {
+            return static_cast<uint32_t>(_mm_movemask_epi8(bytes));
+        }
+
+        __m128i bytes;
+#else
+        explicit group(const uint8_t* ctrl) { std::memcpy(bytes, ctrl, group_width); }
+
+        [[nodiscard]] auto match(const uint8_t tag) const noexcept -> uint32_t
+        {
+            uint32_t mask = 0;
+            for (size_t i = 0; i < group_width; ++i) mask |= static_cast<uint32_t>(bytes[i] == tag) << i;
+            return mask;
+        }
+
+        [[nodiscard]] auto match_empty() const noexcept -> uint32_t { return match(empty_ctrl); }
+
+        uint8_t bytes[group_width];
+#endif
+    };
+
+    // Keys are hashes already, a Fibonacci multiply spreads their entropy into the high bits we probe with.
+    [[nodiscard]] static constexpr auto mix(const uint64_t key) noexcept -> uint64_t { return key * 0x9E3779B97F4A7C15ull; }
+    [[nodiscard]] auto h1(const uint64_t mixed) const noexcept -> size_t { return mixed >> m_shift; }
+    [[nodiscard]] static constexpr auto h2(const uint64_t mixed) noexcept -> uint8_t { return (mixed >> 32) & 0x7F; }
+    [[nodiscard]] static constexpr auto is_empty(const uint8_t ctrl) noexcept -> bool { return ctrl & empty_ctrl; }
+
+    auto set_ctrl(const size_t index, const uint8_t value) noexcept -> void
+    {
+        m_ctrl[index] = value;
+        // The first group is mirrored past the end so unaligned group loads never need to wrap.
+        if (index < group_width) m_ctrl[m_capacity + index] = value;
+    }
+
+    auto insert_unique(const uint64_t key, const T& value) noexcept -> T*
+    {
+        const uint64_t mixed = mix(key);
+        size_t pos           = h1(mixed);
+        for (size_t stride = group_width;; stride += group_width) {
+            if (const uint32_t mask = group{ m_ctrl.get() + pos }.match_empty()) {
+                const size_t index = (pos + std::countr_zero(mask)) & m_mask;
+                set_ctrl(index, h2(mixed));
+                m_slots[index] = slot{ key, value };
+                return &m_slots[index].value;
+            }
+            pos = (pos + stride) & m_mask;
+        }
+    }
+
+    auto grow() -> void { rehash(m_capacity ? m_capacity * 2 : group_width); }
+
+    auto rehash(const size_t capacity) -> void
+    {
+        auto old_ctrl           = std::move(m_ctrl);
+        auto old_slots          = std::move(m_slots);
+        const size_t old_length = m_capacity;
+
+        m_ctrl     = std::make_unique<uint8_t[]>(capacity + group_width);
+        m_slots    = std::make_unique<slot[]>(capacity);
+        m_capacity = capacity;
+        m_mask     = capacity - 1;
+        m_shift    = 64 - std::countr_zero(capacity);
+        std::memset(m_ctrl.get(), empty_ctrl, capacity + group_width);
+
+        for (size_t i = 0; i < old_length; ++i) {
+            if (!is_empty(old_ctrl[i])) insert_unique(old_slots[i].key, old_slots[i].value);
+        }
+    }
+
+    std::unique_ptr<uint8_t[]> m_ctrl;
+    std::unique_ptr<slot[]> m_slots;
+    size_t m_capacity = 0;
+    size_t m_mask     = 0;
+    int m_shift       = 64;
+    size_t m_size     = 0;
+};
+} // namespace reflex::internal
@@ -1,7 +1,19 @@
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include "alias.hpp"
 #include "context.hpp"
 #include "descriptor.hpp"
+#include "epoch.hpp"
+#include "exception.hpp"
+#include "hashed_string.hpp"
 #include "range.hpp"
 
 
@@ -9,34 +21,119 @@ namespace reflex
 {
 class type_handle;
 class field_handle;
+class method_handle;
 
-using field_range = range<field_handle, internal::field_descriptor>;
+using field_range  = range<field_handle, internal::field_descriptor>;
+using method_range = range<method_handle, internal::method_descriptor>;
 
 class type_handle
 {
 public:
-    type_handle(context* ctx, internal::type_descriptor* inner) : m_ctx(ctx), m_inner(inner) { }
+    /**
+     * @param pin Keeps the version of ctx alive while this handle exists, see snapshot.
+     */
+    type_handle(const context* ctx, const internal::type_descriptor* inner, internal::epoch_guard pin = { }) :
+        m_ctx(ctx), m_inner(inner), m_pin(std::move(pin)) { }
 
     auto name() const -> const char* { return m_inner->hash.data(); }
 
+    auto size() const noexcept -> size_t { return m_inner->size; }
+
     auto fields() const -> field_range
     {
         return field_range{
             m_ctx,
             m_inner->fields.data(),
             m_inner->fields.size(),
+            m_pin,
+        };
+    }
+
+    /**
+     * @brief The static fields of this type, which fields() does not list since they are not part of an instance.
+     */
+    auto statics() const -> field_range
+    {
+        return field_range{
+            m_ctx,
+            m_inner->statics.data(),
+            m_inner->statics.size(),
+            m_pin,
+        };
+    }
+
+    /**
+     * @brief Returns the field captured under name, member fields are found before static ones.
+     * @throws reflection_error if this type has no field called name.
+     */
+    auto field(const char* name) const -> field_handle;
+    auto field(const hashed_string& name) const -> field_handle;
+
+    /**
+     * @brief Returns the field captured under name, or nothing if this type has no such field.
+     *
+     * Resolved through a per-type index, so the cost does not grow with the number of fields.
+     */
+    auto find_field(const hashed_string& name) const -> std::optional<field_handle>;
+
+    /**
+     * @brief Whether this type is base or has inherited from it, directly or indirectly, see reflector::base().
+     *
+     * Answered from the ancestor table flattened at capture time, never by walking the hierarchy.
+     */
+    auto is_a(const hashed_string& base) const noexcept -> bool
+    {
+        if (base == m_inner->hash) return true;
+        const auto by_hash = [](const internal::base_descriptor& b) { return b.hash.value(); };
+        return std::ranges::binary_search(m_inner->ancestors, base.value(), { }, by_hash);
+    }
+
+    auto is_a(const type_handle& base) const noexcept -> bool { return is_a(base.m_inner->hash); }
+
+    template <typename B>
+    auto is_a() const noexcept -> bool { return is_a(internal::alias<B>::hash()); }
+
+    auto methods() const -> method_range
+    {
+        return method_range{
+            m_ctx,
+            m_inner->methods.data(),
+            m_inner->methods.size(),
+            m_pin,
         };
     }
 
+    /**
+     * @brief Returns the method captured under name.
+     * @throws reflection_error if this type has no method called name.
+     */
+    auto method(const char* name) const -> method_handle;
+    auto method(const hashed_string& name) const -> method_handle;
+
+    /**
+     * @brief Returns the method captured under name, or nothing if this type has no such method.
+     */
+    auto find_method(const hashed_string& name) const -> std::optional<method_handle>;
+
+    /**
+     * @brief The memcpy runs covering every trivially copyable byte of this type, computed once and cached.
+     */
+    auto copy_plan() const -> const reflex::copy_plan& { return m_ctx->plan_of(*m_inner); }
+
 private:
-    context* m_ctx;
-    internal::type_descriptor* m_inner;
+    const context* m_ctx;
+    const internal::type_descriptor* m_inner;
+    internal::epoch_guard m_pin;
 };
 
 class field_handle
 {
 public:
-    field_handle(context* ctx, internal::field_descriptor* inner) : m_ctx(ctx), m_inner(inner) { }
+    /**
+     * @param pin Keeps the version of ctx alive while this handle exists, see snapshot.
+     */
+    field_handle(const context* ctx, const internal::field_descriptor* inner, internal::epoch_guard pin = { }) :
+        m_ctx(ctx), m_inner(inner), m_pin(std::move(pin)) { }
 
     auto name() const -> const char* { return m_inner->field_hash.data(); }
 
@@ -44,14 +141,307 @@ public:
     {
         return type_handle{
             m_ctx,
-            &m_ctx->at(m_inner->type_hash)
+            &m_ctx->at(m_inner->type_hash),
+            m_pin,
         };
     }
 
-    auto attribute(const char* key) const -> std::any { return m_inner->attributes.at(hashed_string{ key }); }
+    /**
+     * @brief The hash of the name the type of this field has been captured or deduced under.
+     */
+    auto type_hash() const noexcept -> const interned_string& { return m_inner->type_hash; }
+
+    /**
+     * @brief The byte offset of this field from the start of its owning object, 0 for static fields.
+     */
+    auto offset() const noexcept -> size_t { return m_inner->offset; }
+
+    /**
+     * @brief Whether this is a static field, accessed through get(), set() and ref() without an instance.
+     */
+    auto is_static() const noexcept -> bool { return m_inner->address != nullptr; }
+
+    /**
+     * @brief The size of this field in bytes.
+     */
+    auto size() const noexcept -> size_t { return m_inner->size; }
+
+    /**
+     * @brief Reads this field from obj.
+     * @tparam T The type of the field, checked in debug builds.
+     * @throws reflection_error in debug builds if T does not match the captured field type.
+     */
+    template <typename T>
+    auto get(const void* obj) const -> const T&
+    {
+        check_type<T>();
+        check_static(false);
+        return *reinterpret_cast<const T*>(static_cast<const std::byte*>(obj) + m_inner->offset);
+    }
+
+    /**
+     * @brief Reads this static field straight from its address.
+     * @tparam T The type of the field, checked in debug builds.
+     * @throws reflection_error in debug builds if T does not match the captured field type or the field is
+     * not static.
+     */
+    template <typename T>
+    auto get() const -> const T&
+    {
+        check_type<T>();
+        check_static(true);
+        return *static_cast<const T*>(m_inner->address);
+    }
+
+    /**
+     * @brief Assigns value to this field of obj.
+     * @tparam T The type of the field, checked in debug builds.
+     * @throws reflection_error in debug builds if T does not match the captured field type.
+     */
+    template <typename T>
+    auto set(void* obj, const T& value) const -> void
+    {
+        check_type<T>();
+        check_static(false);
+        ref<T>(obj) = value;
+    }
+
+    /**
+     * @brief Assigns value to this static field.
+     * @tparam T The type of the field, checked in debug builds.
+     * @throws reflection_error in debug builds if T does not match the captured field type or the field is
+     * not static.
+     */
+    template <typename T>
+    auto set(const T& value) const -> void
+    {
+        check_type<T>();
+        check_static(true);
+        ref<T>() = value;
+    }
+
+    /**
+     * @brief Returns a reference to this field of obj without any type checking.
+     */
+    template <typename T>
+    auto ref(void* obj) const noexcept -> T&
+    {
+        return *reinterpret_cast<T*>(static_cast<std::byte*>(obj) + m_inner->offset);
+    }
+
+    /**
+     * @brief Returns a reference to this static field without any checking.
+     */
+    template <typename T>
+    auto ref() const noexcept -> T&
+    {
+        return *static_cast<T*>(m_inner->address);
+    }
+
+    /**
+     * @brief Returns the attribute value stored under key.
+     * @tparam T The exact type the attribute was decorated with.
+     * @throws reflection_error if there is no attribute under key or it holds another type.
+     */
+    template <typename T>
+    auto attribute(const char* key) const -> const T&
+    {
+        return attribute<T>(hashed_string{ key });
+    }
+
+    /**
+     * @brief Returns the attribute value stored under the hashed key, e.g. attribute<float>("min"_hs), which
+     * skips hashing the key at runtime.
+     * @throws reflection_error if there is no attribute under key or it holds another type.
+     */
+    template <typename T>
+    auto attribute(const hashed_string& key) const -> const T&
+    {
+        const T* value = find_attribute<T>(key);
+        if (!value) throw reflection_error{ "Attribute does not exist or holds a different type." };
+        return *value;
+    }
+
+    /**
+     * @brief Returns the attribute value stored under key, or nullptr if it is missing or holds another type.
+     */
+    template <typename T>
+    auto find_attribute(const char* key) const noexcept -> const T*
+    {
+        return find_attribute<T>(hashed_string{ key });
+    }
+
+    template <typename T>
+    auto find_attribute(const hashed_string& key) const noexcept -> const T*
+    {
+        const internal::attribute* attr = m_inner->attributes.find(key.value());
+        return attr ? attr->get<T>() : nullptr;
+    }
+
+    auto has_attribute(const char* key) const noexcept -> bool { return has_attribute(hashed_string{ key }); }
+
+    auto has_attribute(const hashed_string& key) const noexcept -> bool
+    {
+        return m_inner->attributes.find(key.value()) != nullptr;
+    }
 
 private:
-    context* m_ctx;
-    internal::field_descriptor* m_inner;
+    template <typename T>
+    auto check_type() const -> void
+    {
+#ifndef NDEBUG
+        // types are named after their deduced type name unless captured under another one, so the hash tells
+        // them apart, the size check guards against a different type captured under the same name elsewhere
+        if (internal::alias<T>::hash() != m_inner->type_hash || sizeof(T) != m_inner->size) {
+            throw reflection_error{ "Attempted to access a field as the wrong type." };
+        }
+#endif
+    }
+
+    auto check_static([[maybe_unused]] const bool expected) const -> void
+    {
+#ifndef NDEBUG
+        if (is_static() != expected) {
+            throw reflection_error{ expected ? "Attempted to access a member field without an instance."
+                                             : "Attempted to access a static field through an instance." };
+        }
+#endif
+    }
+
+    const context* m_ctx;
+    const internal::field_descriptor* m_inner;
+    internal::epoch_guard m_pin;
 };
+
+class method_handle
+{
+public:
+    /**
+     * @param pin Keeps the version of ctx alive while this handle exists, see snapshot.
+     */
+    method_handle(const context* ctx, const internal::method_descriptor* inner, internal::epoch_guard pin = { }) :
+        m_ctx(ctx), m_inner(inner), m_pin(std::move(pin)) { }
+
+    auto name() const -> const char* { return m_inner->method_hash.data(); }
+
+    /**
+     * @brief The hash of the name the return type has been captured or deduced under.
+     */
+    auto return_hash() const noexcept -> const interned_string& { return m_inner->return_hash; }
+
+    /**
+     * @brief The hashes of the argument types in declaration order, stripped of references and cv qualifiers.
+     */
+    auto argument_hashes() const noexcept -> std::span<const interned_string>
+    {
+        return { m_inner->argument_hashes.data(), m_inner->argument_hashes.size() };
+    }
+
+    auto arity() const noexcept -> size_t { return m_inner->argument_hashes.size(); }
+
+    /**
+     * @brief Whether the method may be called on a const object.
+     */
+    auto is_const() const noexcept -> bool { return m_inner->is_const; }
+
+    /**
+     * @brief Calls this method on obj without any type checking, one indirect call through the trampoline.
+     * @param obj The object to call the method on, of the type the method has been captured for.
+     * @param args The address of every argument in declaration order, usually an array on the caller's
+     * stack. By value parameters are copied from it, rvalue reference parameters may be moved from.
+     * @param ret Uninitialized storage for the return value, which is constructed into it and then owned by
+     * the caller, or nullptr to discard it.
+     */
+    auto invoke(void* obj, void* const* args, void* ret = nullptr) const -> void { m_inner->thunk(obj, args, ret); }
+
+    /**
+     * @brief Calls this method on obj with args, packing their addresses on the stack.
+     * @tparam R The exact return type of the method, checked in debug builds. References are returned as
+     * references to the object the method returned.
+     * @param args Arguments of the exact parameter types, checked in debug builds.
+     * @throws reflection_error in debug builds if R or the argument types do not match the captured method.
+     */
+    template <typename R = void, typename... Args>
+    auto call(void* obj, Args&&... args) const -> R
+    {
+        check_signature<R, Args...>();
+        void* packed[sizeof...(Args) + 1] = { const_cast<void*>(static_cast<const void*>(std::addressof(args)))... };
+        if constexpr (std::is_void_v<R>) {
+            invoke(obj, packed);
+        } else if constexpr (std::is_reference_v<R>) {
+            // the thunk stores the address of the referred object
+            std::add_pointer_t<R> result = nullptr;
+            invoke(obj, packed, &result);
+            return static_cast<R>(*result);
+        } else {
+            alignas(R) std::byte storage[sizeof(R)];
+            invoke(obj, packed, storage);
+            R* result = std::launder(reinterpret_cast<R*>(storage));
+            R value   = std::move(*result);
+            result->~R();
+            return value;
+        }
+    }
+
+private:
+    template <typename R, typename... Args>
+    auto check_signature() const -> void
+    {
+#ifndef NDEBUG
+        const auto& captured       = m_inner->argument_hashes;
+        size_t i                   = 0;
+        const bool arguments_match = sizeof...(Args) == arity() &&
+                                     ((internal::alias<std::remove_cvref_t<Args>>::hash() == captured[i++]) && ...);
+        if (internal::alias<std::remove_cvref_t<R>>::hash() != m_inner->return_hash || !arguments_match) {
+            throw reflection_error{ "Attempted to call a method with the wrong signature." };
+        }
+#endif
+    }
+
+    const context* m_ctx;
+    const internal::method_descriptor* m_inner;
+    internal::epoch_guard m_pin;
+};
+
+inline auto type_handle::field(const char* name) const -> field_handle { return field(hashed_string{ name }); }
+
+inline auto type_handle::field(const hashed_string& name) const -> field_handle
+{
+    const uint32_t index = m_inner->field_names.find(name.value());
+    if (index != internal::field_index::npos) return field_handle{ m_ctx, &m_inner->fields[index], m_pin };
+
+    const uint32_t static_index = m_inner->static_names.find(name.value());
+    if (static_index == internal::field_index::npos) {
+        throw reflection_error{ "Attempted to access field that has not been captured." };
+    }
+    return field_handle{ m_ctx, &m_inner->statics[static_index], m_pin };
+}
+
+inline auto type_handle::find_field(const hashed_string& name) const -> std::optional<field_handle>
+{
+    const uint32_t index = m_inner->field_names.find(name.value());
+    if (index != internal::field_index::npos) return field_handle{ m_ctx, &m_inner->fields[index], m_pin };
+
+    const uint32_t static_index = m_inner->static_names.find(name.value());
+    if (static_index == internal::field_index::npos) return std::nullopt;
+    return field_handle{ m_ctx, &m_inner->statics[static_index], m_pin };
+}
+
+inline auto type_handle::method(const char* name) const -> method_handle { return method(hashed_string{ name }); }
+
+inline auto type_handle::method(const hashed_string& name) const -> method_handle
+{
+    const uint32_t index = m_inner->method_names.find(name.value());
+    if (index == internal::field_index::npos) {
+        throw reflection_error{ "Attempted to access method that has not been captured." };
+    }
+    return method_handle{ m_ctx, &m_inner->methods[index], m_pin };
+}
+
+inline auto type_handle::find_method(const hashed_string& name) const -> std::optional<method_handle>
+{
+    const uint32_t index = m_inner->method_names.find(name.value());
+    if (index == internal::field_index::npos) return std::nullopt;
+    return method_handle{ m_ctx, &m_inner->methods[index], m_pin };
+}
 }
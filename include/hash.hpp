@@ -0,0 +1,155 @@
+/**
+ * @file hash.hpp
+ * @brief The string hash policies hashed_string can be instantiated with.
+ */
+#pragma once
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+
+namespace reflex
+{
+namespace internal
+{
+#if defined(__SIZEOF_INT128__)
+/// @brief __extension__ keeps -Wpedantic from flagging the non standard type.
+__extension__ typedef unsigned __int128 uint128;
+#endif
+
+/**
+ * @brief Returns the high 64 bits of the 128-bit product a * b.
+ */
+[[nodiscard]] constexpr auto mulhi(const uint64_t a, const uint64_t b) noexcept -> uint64_t
+{
+#if defined(__SIZEOF_INT128__)
+    return static_cast<uint64_t>((static_cast<uint128>(a) * b) >> 64);
+#else
+    const uint64_t a_lo = a & 0xFFFFFFFF, a_hi = a >> 32;
+    const uint64_t b_lo = b & 0xFFFFFFFF, b_hi = b >> 32;
+    const uint64_t lo_lo = a_lo * b_lo, hi_lo = a_hi * b_lo, lo_hi = a_lo * b_hi, hi_hi = a_hi * b_hi;
+    const uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFF) + lo_hi;
+    return hi_hi + (hi_lo >> 32) + (cross >> 32);
+#endif
+}
+
+/**
+ * @brief Reads N bytes at bytes as a little endian integer, through a single load unless constant evaluated.
+ */
+template <size_t N>
+[[nodiscard]] constexpr auto read(const char* bytes) noexcept -> uint64_t
+{
+    if (!std::is_constant_evaluated() && std::endian::native == std::endian::little) {
+        std::conditional_t<N == 8, uint64_t, uint32_t> word;
+        std::memcpy(&word, bytes, N);
+        return word;
+    }
+    uint64_t word = 0;
+    for (size_t i = 0; i < N; ++i) word |= uint64_t{ static_cast<uint8_t>(bytes[i]) } << (8 * i);
+    return word;
+}
+} // namespace internal
+
+/// @brief A hash policy, mapping the first length characters of string to 64 bits in a constant expression.
+template <typename H>
+concept string_hasher = requires(const char* string, size_t length) {
+    { H::hash(string, length) } noexcept -> std::same_as<uint64_t>;
+};
+
+/**
+ * @brief 64-bit FNV-1a, one multiply per byte. The hash reflex used originally, kept so hashes persisted
+ * by older versions stay valid, see REFLEX_FNV1A_HASH.
+ * @see https://en.wikipedia.org/wiki/Fowler%E2%80%93Noll%E2%80%93Vo_hash_function
+ */
+struct fnv1a
+{
+    static constexpr uint64_t prime  = 1099511628211ull;
+    static constexpr uint64_t offset = 14695981039346656037ull;
+
+    [[nodiscard]] static constexpr auto hash(const char* string, const size_t length) noexcept -> uint64_t
+    {
+        uint64_t hash = offset;
+        for (size_t i = 0; i < length; ++i) {
+            hash ^= static_cast<uint64_t>(string[i]);
+            hash *= prime;
+        }
+        return hash;
+    }
+};
+
+/**
+ * @brief A wyhash style hash consuming 16 bytes per multiply, or 48 over three independent lanes for long
+ * names such as qualified template types. Strings up to 16 bytes take a fixed number of loads regardless of
+ * their length, and the final 128-bit multiply folds every input bit into every output bit.
+ * @see https://github.com/wangyi-fudan/wyhash
+ */
+struct wyhash
+{
+    static constexpr uint64_t secret[4] = {
+        0x2d358dccaa6c78a5ull,
+        0x8bb84b93962eacc9ull,
+        0x4b33a62ed433d4a3ull,
+        0x4d5a2da51de1aa47ull,
+    };
+
+    [[nodiscard]] static constexpr auto hash(const char* string, const size_t length) noexcept -> uint64_t
+    {
+        using internal::read;
+
+        const char* p = string;
+        uint64_t seed = mix(secret[0], secret[1]);
+        uint64_t a = 0, b = 0;
+        if (length <= 16) {
+            if (length >= 4) {
+                // two overlapping pairs of 4 byte reads cover every length from 4 to 16
+                const size_t step = (length >> 3) << 2;
+                a                 = read<4>(p) << 32 | read<4>(p + step);
+                b                 = read<4>(p + length - 4) << 32 | read<4>(p + length - 4 - step);
+            } else if (length > 0) {
+                a = uint64_t{ static_cast<uint8_t>(p[0]) } << 16 |
+                    uint64_t{ static_cast<uint8_t>(p[length >> 1]) } << 8 | static_cast<uint8_t>(p[length - 1]);
+            }
+        } else {
+            size_t i = length;
+            if (i > 48) {
+                uint64_t lane1 = seed, lane2 = seed;
+                do {
+                    seed  = mix(read<8>(p) ^ secret[1], read<8>(p + 8) ^ seed);
+                    lane1 = mix(read<8>(p + 16) ^ secret[2], read<8>(p + 24) ^ lane1);
+                    lane2 = mix(read<8>(p + 32) ^ secret[3], read<8>(p + 40) ^ lane2);
+                    p += 48;
+                    i -= 48;
+                } while (i > 48);
+                seed ^= lane1 ^ lane2;
+            }
+            while (i > 16) {
+                seed = mix(read<8>(p) ^ secret[1], read<8>(p + 8) ^ seed);
+                p += 16;
+                i -= 16;
+            }
+            a = read<8>(p + i - 16);
+            b = read<8>(p + i - 8);
+        }
+        a ^= secret[1];
+        b ^= seed;
+        return mix(a * b ^ secret[0] ^ length, internal::mulhi(a, b) ^ secret[1]);
+    }
+
+private:
+    [[nodiscard]] static constexpr auto mix(const uint64_t a, const uint64_t b) noexcept -> uint64_t
+    {
+        return a * b ^ internal::mulhi(a, b);
+    }
+};
+
+#ifdef REFLEX_FNV1A_HASH
+using default_hasher = fnv1a;
+#else
+/// @brief The policy of hashed_string, define REFLEX_FNV1A_HASH to keep the FNV-1a hashes of older versions.
+using default_hasher = wyhash;
+#endif
+} // namespace reflex
@@ -1,46 +1,47 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <string>
+#include "hash.hpp"
 
 
 namespace reflex
 {
-namespace internal
-{
-// Magic numbers used for 64-bit FNV-1a hashing.
-
-constexpr auto prime  = 1099511628211ull;
-constexpr auto offset = 14695981039346656037ull;
-}
-
-
 /**
  * @brief A class representing a hashed string.
+ * @tparam Hasher The hash policy, see hash.hpp. Hashes of different policies never compare equal.
  */
-class hashed_string
+template <string_hasher Hasher>
+class basic_hashed_string
 {
 public:
+    using hasher = Hasher;
+
     /**
-     * @brief Creates a new hashes_string using the FNV-1a hash algorithm.
-     * @see https://en.wikipedia.org/wiki/Fowler%E2%80%93Noll%E2%80%93Vo_hash_function
+     * @brief Creates a new hashed string, measuring the string first so the hasher can consume it a word at
+     * a time.
      * @param string The null terminated string to hash.
      * @return A 64-bit hash of the input string.
      */
-    constexpr explicit hashed_string(const char* string) : m_hash(internal::offset), m_name(string), m_length(0)
+    constexpr explicit basic_hashed_string(const char* string) :
+        m_hash(0), m_name(string), m_length(std::char_traits<char>::length(string))
     {
-        for (const char* c = string; *c; c++) {
-            m_hash ^= *c;
-            m_hash *= internal::prime;
-            m_length++;
-        }
+        m_hash = Hasher::hash(string, m_length);
     }
 
-    constexpr explicit hashed_string() : m_hash(0), m_name(nullptr), m_length(0) { }
+    constexpr explicit basic_hashed_string() : m_hash(0), m_name(nullptr), m_length(0) { }
+
+    /**
+     * @brief Adopts hash, computed earlier for the length characters at string, without hashing again.
+     */
+    constexpr basic_hashed_string(const uint64_t hash, const char* string, const size_t length) noexcept :
+        m_hash(hash), m_name(string), m_length(length) { }
 
     /**
      * @brief Three-way comparison between two hashed_string's.
      */
-    [[nodiscard]] constexpr auto operator<=>(const hashed_string& other) const noexcept
+    [[nodiscard]] constexpr auto operator<=>(const basic_hashed_string& other) const noexcept
     {
         return m_hash <=> other.m_hash;
     }
@@ -48,7 +49,7 @@ public:
     /**
      * @brief Equality comparison.
      */
-    [[nodiscard]] constexpr auto operator==(const hashed_string& other) const noexcept -> bool
+    [[nodiscard]] constexpr auto operator==(const basic_hashed_string& other) const noexcept -> bool
     {
         return m_hash == other.m_hash;
     }
@@ -56,11 +57,21 @@ public:
     /**
      * @brief Inequality comparison.
      */
-    [[nodiscard]] constexpr auto operator!=(const hashed_string& other) const noexcept -> bool
+    [[nodiscard]] constexpr auto operator!=(const basic_hashed_string& other) const noexcept -> bool
     {
         return !(*this == other);
     }
 
+    /**
+     * @brief Compares the strings behind both hashes, telling apart names whose hashes collide. Falls back to
+     * comparing the hashes when either has no string.
+     */
+    [[nodiscard]] constexpr auto same_string(const basic_hashed_string& other) const noexcept -> bool
+    {
+        if (!m_name || !other.m_name) return m_hash == other.m_hash;
+        return m_length == other.m_length && std::char_traits<char>::compare(m_name, other.m_name, m_length) == 0;
+    }
+
     /**
      * @brief Returns the computed 64-bit hash.
      */
@@ -78,6 +89,16 @@ public:
 
     [[nodiscard]] explicit operator bool() const noexcept { return m_hash != 0; }
 
+    /**
+     * @brief Returns the same hash referring to copy, which must hold the same characters as data().
+     */
+    [[nodiscard]] constexpr auto relocated(const char* copy) const noexcept -> basic_hashed_string
+    {
+        basic_hashed_string moved = *this;
+        moved.m_name        = copy;
+        return moved;
+    }
+
 private:
     /// @brief The computed hash.
     uint64_t m_hash;
@@ -86,18 +107,44 @@ private:
     /// @brief The length of the original string.
     size_t m_length;
 };
+
+using hashed_string = basic_hashed_string<default_hasher>;
+
+namespace internal
+{
+/**
+ * @brief Pairs the characters at string with hash, whatever they hash to. Only for tests, which forge the
+ * collisions a 64-bit hash makes impractical to find, everywhere else a hash belongs to its characters.
+ */
+[[nodiscard]] inline auto forged_hash(const uint64_t hash, const char* string) noexcept -> hashed_string
+{
+    return hashed_string{ hash, string, std::char_traits<char>::length(string) };
+}
+} // namespace internal
+
+inline namespace literals
+{
+/**
+ * @brief Hashes a string literal at compile time, e.g. "pos_component"_hs. Being consteval, it can never fall
+ * back to hashing at runtime, so lookups keyed by it are a pure integer probe.
+ */
+consteval auto operator""_hs(const char* string, const size_t) -> hashed_string
+{
+    return hashed_string{ string };
+}
+} // namespace literals
 } // namespace reflex
 
 /**
- * @brief Specialization of std::hash for reflex::hashed_string.
+ * @brief Specialization of std::hash for reflex::basic_hashed_string.
  *
  * Allows hashed_string to be used as a key in std::unordered_map or
  * std::unordered_set.
  */
-template <>
-struct std::hash<reflex::hashed_string>
+template <typename Hasher>
+struct std::hash<reflex::basic_hashed_string<Hasher>>
 {
-    size_t operator()(const reflex::hashed_string& s) const noexcept
+    size_t operator()(const reflex::basic_hashed_string<Hasher>& s) const noexcept
     {
         return s.value();
     }
@@ -0,0 +1,75 @@
+/**
+ * @file meta.hpp
+ * @brief Opt in compile time field lists, visited without touching a context.
+ */
+#pragma once
+
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "traits.hpp"
+
+
+namespace reflex
+{
+/**
+ * @brief A member field known at compile time, the same pointer reflector<T>::field is instantiated with.
+ */
+template <auto Ptr>
+    requires member_field_ptr<Ptr>
+struct field
+{
+    using field_type = typename member_info<decltype(Ptr)>::field_type;
+    using class_type = typename member_info<decltype(Ptr)>::class_type;
+
+    static constexpr auto pointer = Ptr;
+
+    constexpr explicit field(const char* field_name) : name(field_name) { }
+
+    const char* name;
+};
+
+/**
+ * @brief Compile time description of T. Specialize it with a static constexpr tuple of fields:
+ * @code
+ * template <>
+ * struct reflex::meta<pos_component>
+ * {
+ *     static constexpr auto fields = std::tuple{
+ *         reflex::field<&pos_component::x>{ "x" },
+ *         reflex::field<&pos_component::y>{ "y" },
+ *     };
+ * };
+ * @endcode
+ */
+template <typename T>
+struct meta;
+
+/// @brief A type with a meta specialization.
+template <typename T>
+concept has_meta = requires { std::tuple_size<std::remove_cvref_t<decltype(meta<T>::fields)>>::value; };
+
+/**
+ * @brief Calls visitor(name, member) for every field listed in meta<T>, in declaration order.
+ *
+ * The loop is unrolled by a fold expression so each call sees a constant member pointer, letting the
+ * compiler generate the same code as hand written member access.
+ */
+template <typename T, typename Visitor>
+    requires has_meta<std::remove_cvref_t<T>>
+constexpr auto for_each_field(T&& obj, Visitor&& visitor) -> void
+{
+    std::apply(
+            [&]<typename... Fields>(const Fields&... fields) {
+                (visitor(fields.name, std::forward<T>(obj).*Fields::pointer), ...);
+            },
+            meta<std::remove_cvref_t<T>>::fields);
+}
+
+/**
+ * @brief The number of fields listed in meta<T>.
+ */
+template <typename T>
+    requires has_meta<T>
+constexpr size_t field_count = std::tuple_size_v<std::remove_cvref_t<decltype(meta<T>::fields)>>;
+} // namespace reflex
@@ -0,0 +1,132 @@
+/**
+ * @file path.hpp
+ * @brief Dotted field paths such as "transform.position.x" compiled down to a single offset.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include "alias.hpp"
+#include "exception.hpp"
+#include "handle.hpp"
+#include "hashed_string.hpp"
+
+
+namespace reflex
+{
+/**
+ * @brief A nested field reached through a chain of captured fields, resolved once against a context.
+ *
+ * Fields are always held by value, so every hop only adds its offset and the whole chain collapses into
+ * one cumulative offset from the root object. Accessing through a path is then a single addition, no
+ * matter how deep it reaches. A path holds no reference to the context it was compiled against, it is
+ * trivially copyable and stays valid for as long as the layouts along the chain do not change.
+ *
+ * @code
+ * const reflex::path x{ reflex::lookup<entity>(ctx), "transform.position.x" };
+ * x.set(&e, 4.f);
+ * @endcode
+ */
+class path
+{
+public:
+    /**
+     * @brief Resolves dotted, a '.' separated chain of field names starting at root.
+     * @throws reflection_error if a segment is empty or does not name a member field, or a field which is
+     * followed by further segments has a type which has not been captured.
+     */
+    path(const type_handle& root, const std::string_view dotted)
+    {
+        type_handle current = root;
+        std::string segment;
+        for (size_t begin = 0;;) {
+            const size_t end = std::min(dotted.find('.', begin), dotted.size());
+            segment.assign(dotted.substr(begin, end - begin));
+            if (segment.empty()) {
+                throw reflection_error{ "Path '" + std::string{ dotted } + "' has an empty segment." };
+            }
+
+            const std::optional<field_handle> field = current.find_field(hashed_string{ segment.c_str() });
+            if (!field || field->is_static()) {
+                throw reflection_error{ "Path segment '" + segment + "' is not a field of '" + current.name() + "'." };
+            }
+            m_offset += field->offset();
+            if (end == dotted.size()) {
+                m_type_hash = field->type_hash().value();
+                m_size      = field->size();
+                return;
+            }
+            current = field->type();
+            begin   = end + 1;
+        }
+    }
+
+    /**
+     * @brief The byte offset of the final field from the start of the root object.
+     */
+    [[nodiscard]] auto offset() const noexcept -> size_t { return m_offset; }
+
+    /**
+     * @brief The size of the final field in bytes.
+     */
+    [[nodiscard]] auto size() const noexcept -> size_t { return m_size; }
+
+    /**
+     * @brief The hash value of the name the type of the final field has been captured or deduced under. Only
+     * the value is kept, the name itself is owned by the context.
+     */
+    [[nodiscard]] auto type_hash() const noexcept -> uint64_t { return m_type_hash; }
+
+    /**
+     * @brief Reads the final field from root.
+     * @tparam T The type of the final field, checked in debug builds.
+     * @throws reflection_error in debug builds if T does not match the captured field type.
+     */
+    template <typename T>
+    auto get(const void* root) const -> const T&
+    {
+        check_type<T>();
+        return *reinterpret_cast<const T*>(static_cast<const std::byte*>(root) + m_offset);
+    }
+
+    /**
+     * @brief Assigns value to the final field of root.
+     * @tparam T The type of the final field, checked in debug builds.
+     * @throws reflection_error in debug builds if T does not match the captured field type.
+     */
+    template <typename T>
+    auto set(void* root, const T& value) const -> void
+    {
+        check_type<T>();
+        ref<T>(root) = value;
+    }
+
+    /**
+     * @brief Returns a reference to the final field of root without any type checking.
+     */
+    template <typename T>
+    auto ref(void* root) const noexcept -> T&
+    {
+        return *reinterpret_cast<T*>(static_cast<std::byte*>(root) + m_offset);
+    }
+
+private:
+    template <typename T>
+    auto check_type() const -> void
+    {
+#ifndef NDEBUG
+        if (internal::alias<T>::hash().value() != m_type_hash || sizeof(T) != m_size) {
+            throw reflection_error{ "Attempted to access a path as the wrong type." };
+        }
+#endif
+    }
+
+    size_t m_offset = 0;
+    size_t m_size   = 0;
+    uint64_t m_type_hash = 0;
+};
+} // namespace reflex
@@ -0,0 +1,104 @@
+/**
+ * @file perfect_hash.hpp
+ * @brief A minimal perfect hash function over a fixed set of precomputed 64-bit hashes.
+ */
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <vector>
+#include "exception.hpp"
+#include "hash.hpp"
+
+
+namespace reflex::internal
+{
+/**
+ * @brief A PTHash style minimal perfect hash function.
+ *
+ * Keys are split into buckets with a multiply-shift, each bucket stores a small "pilot" chosen at build time
+ * so that every key of the bucket lands on its own slot in [0, size()). Evaluating it is a multiply-shift,
+ * one pilot load and one multiply-high, and the caller confirms membership with a single key compare since
+ * keys that were not part of the build set also map to some slot.
+ */
+class perfect_hash
+{
+public:
+    perfect_hash() = default;
+
+    /**
+     * @brief Builds the function over keys, which must be unique.
+     */
+    explicit perfect_hash(const std::span<const uint64_t> keys) : m_size(keys.size())
+    {
+        if (keys.empty()) return;
+
+        // around four keys per bucket keeps the pilot search short while the table stays tiny
+        const size_t bucket_count = std::bit_ceil(std::max<size_t>(1, keys.size() / 4));
+        m_shift                   = 64 - std::countr_zero(bucket_count);
+        m_pilots.assign(bucket_count, 0);
+
+        std::vector<std::vector<uint64_t>> buckets(bucket_count);
+        for (const uint64_t key : keys) buckets[bucket(key)].push_back(key);
+
+        // place the largest buckets first while most slots are still free
+        std::vector<size_t> order(bucket_count);
+        std::iota(order.begin(), order.end(), size_t{ 0 });
+        std::stable_sort(order.begin(), order.end(), [&](const size_t a, const size_t b) {
+            return buckets[a].size() > buckets[b].size();
+        });
+
+        std::vector<bool> taken(m_size, false);
+        std::vector<size_t> candidate;
+        for (const size_t b : order) {
+            const auto& members = buckets[b];
+            if (members.empty()) break;
+
+            for (uint32_t pilot = 0;; ++pilot) {
+                if (pilot == UINT32_MAX) throw reflection_error{ "Failed to build a perfect hash, are keys unique?" };
+
+                candidate.clear();
+                for (const uint64_t key : members) {
+                    const size_t s = slot(key, pilot);
+                    if (taken[s] || std::find(candidate.begin(), candidate.end(), s) != candidate.end()) break;
+                    candidate.push_back(s);
+                }
+                if (candidate.size() != members.size()) continue;
+
+                for (const size_t s : candidate) taken[s] = true;
+                m_pilots[b] = pilot;
+                break;
+            }
+        }
+    }
+
+    /**
+     * @brief Maps key to a slot in [0, size()). Keys from the build set never share a slot.
+     */
+    [[nodiscard]] auto operator()(const uint64_t key) const noexcept -> size_t
+    {
+        return slot(key, m_pilots[bucket(key)]);
+    }
+
+    [[nodiscard]] auto size() const noexcept -> size_t { return m_size; }
+    [[nodiscard]] auto empty() const noexcept -> bool { return m_size == 0; }
+
+private:
+    [[nodiscard]] auto bucket(const uint64_t key) const noexcept -> size_t
+    {
+        return m_shift == 64 ? 0 : (key * 0x9E3779B97F4A7C15ull) >> m_shift;
+    }
+
+    [[nodiscard]] auto slot(const uint64_t key, const uint32_t pilot) const noexcept -> size_t
+    {
+        return mulhi((key ^ (pilot * 0xC2B2AE3D27D4EB4Full)) * 0xFF51AFD7ED558CCDull, m_size);
+    }
+
+    std::vector<uint32_t> m_pilots;
+    size_t m_size = 0;
+    int m_shift   = 64;
+};
+} // namespace reflex::internal
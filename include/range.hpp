@@ -1,49 +1,109 @@
 #pragma once
 
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <utility>
 #include "context.hpp"
+#include "epoch.hpp"
 
 namespace reflex
 {
 
+/**
+ * @brief A random access iterator over contiguous descriptors, yielding a Handle to each on dereference.
+ *
+ * Handles are made by value, so like the iterator of std::vector<bool> this is a proxy iterator, which can
+ * not model std::contiguous_iterator. range::data() exposes the descriptors themselves. Dereferencing yields
+ * a prvalue, so legacy algorithms only see an input iterator through iterator_category, and as the iterator
+ * is not std::indirectly_writable the range can not be sorted or permuted, e.g. by std::ranges::sort, while
+ * std::ranges algorithms which only read still see iterator_concept and random access. Every iterator keeps
+ * a copy of the pin of its range, whose count is only ever touched by the thread that pinned it, so iterators
+ * of a range obtained through a snapshot must stay on that thread. Ranges of a context have no pin and may
+ * be handed to any thread, split with std::views::drop or std::views::take.
+ */
 template <typename Handle, typename Descriptor>
 class iterator
 {
 public:
-    iterator(context* ctx, internal::field_descriptor* data) : m_ctx(ctx), m_data(data) { }
+    using iterator_concept  = std::random_access_iterator_tag;
+    using iterator_category = std::input_iterator_tag;
+    using value_type        = Handle;
+    using difference_type   = std::ptrdiff_t;
+    using reference         = Handle;
+
+    iterator() = default;
+
+    iterator(const context* ctx, const Descriptor* data, internal::epoch_guard pin = { }) :
+        m_ctx(ctx), m_data(data), m_pin(std::move(pin)) { }
 
     auto operator++() -> iterator& { ++m_data; return *this; }
     auto operator++(int) -> iterator { const auto it = *this; ++*this; return it; }
     auto operator--() -> iterator& { --m_data; return *this; }
     auto operator--(int) -> iterator { const auto it = *this; --*this; return it; }
 
-    auto operator[](const size_t index) const -> Handle { return Handle{m_ctx, m_data + index}; }
-    auto operator->() const -> Handle { return operator[](0); }
+    auto operator+=(const difference_type n) -> iterator& { m_data += n; return *this; }
+    auto operator-=(const difference_type n) -> iterator& { m_data -= n; return *this; }
+
+    friend auto operator+(iterator it, const difference_type n) -> iterator { return it += n; }
+    friend auto operator+(const difference_type n, iterator it) -> iterator { return it += n; }
+    friend auto operator-(iterator it, const difference_type n) -> iterator { return it -= n; }
+    friend auto operator-(const iterator& a, const iterator& b) -> difference_type { return a.m_data - b.m_data; }
+
+    /// @brief Holds the handle it->member is called on, which would otherwise be a temporary.
+    struct arrow
+    {
+        Handle handle;
+        auto operator->() const noexcept -> const Handle* { return &handle; }
+    };
+
+    auto operator[](const difference_type index) const -> Handle { return Handle{ m_ctx, m_data + index, m_pin }; }
+    auto operator->() const -> arrow { return arrow{ operator[](0) }; }
     auto operator*() const -> Handle { return operator[](0); }
 
     auto operator==(const iterator& other) const -> bool { return m_data == other.m_data; }
-    auto operator!=(const iterator& other) const -> bool { return m_data != other.m_data; }
+    auto operator<=>(const iterator& other) const -> std::strong_ordering { return m_data <=> other.m_data; }
 
 private:
-    context* m_ctx;
-    Descriptor* m_data;
+    const context* m_ctx     = nullptr;
+    const Descriptor* m_data = nullptr;
+    internal::epoch_guard m_pin;
 };
 
+/**
+ * @brief A sized, random access view over the descriptors of a type, e.g. its fields, see type_handle::fields().
+ *
+ * Its iterators carry everything they need, so they stay valid after the range itself is gone and can be
+ * sliced further with std::views::drop, std::views::take or std::views::counted for batched work.
+ */
 template <typename Handle, typename Descriptor>
-class range
+class range : public std::ranges::view_interface<range<Handle, Descriptor>>
 {
 public:
-    using iterator = iterator<Handle, Descriptor>;
+    using iterator = reflex::iterator<Handle, Descriptor>;
 
-    range(context* ctx, internal::field_descriptor* data, const size_t size) : m_ctx(ctx), m_data(data),
-        m_size(size) { }
+    range(const context* ctx, const Descriptor* data, const size_t size, internal::epoch_guard pin = { }) :
+        m_ctx(ctx), m_data(data), m_size(size), m_pin(std::move(pin)) { }
 
-    auto begin() const -> iterator { return iterator{ m_ctx, m_data }; }
+    auto begin() const -> iterator { return iterator{ m_ctx, m_data, m_pin }; }
     auto end() const -> iterator { return iterator{ m_ctx, m_data + m_size }; }
 
+    auto size() const noexcept -> size_t { return m_size; }
+
+    /**
+     * @brief The descriptors the handles refer to, size() of them laid out contiguously.
+     */
+    auto data() const noexcept -> const Descriptor* { return m_data; }
+
 private:
-    context* m_ctx;
-    Descriptor* m_data;
+    const context* m_ctx;
+    const Descriptor* m_data;
     size_t m_size;
+    internal::epoch_guard m_pin;
 };
 
 }
+
+template <typename Handle, typename Descriptor>
+inline constexpr bool std::ranges::enable_borrowed_range<reflex::range<Handle, Descriptor>> = true;
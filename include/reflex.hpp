@@ -4,11 +4,22 @@
  */
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+#include <vector>
 #include "context.hpp"
 #include "exception.hpp"
+#include "field_table.hpp"
 #include "hashed_string.hpp"
 #include "handle.hpp"
+#include "meta.hpp"
+#include "path.hpp"
 #include "range.hpp"
+#include "serialize.hpp"
+#include "snapshot.hpp"
 #include "alias.hpp"
 #include "capture.hpp"
 
@@ -22,45 +33,169 @@ namespace reflex
  * @tparam T The type to capture.
  * @param ctx The context to capture into.
  * @param type_name The name to associate with T.
+ * @throws reflection_error if ctx has been frozen.
  * @return An instance of a reflector, used to sequentially capture a new type.
  */
 template <typename T>
-auto capture(context& ctx, const char* type_name) noexcept -> reflector<T>
+auto capture(context& ctx, const char* type_name) -> reflector<T>
 {
-    return reflector<T>(&ctx, internal::alias<T>{ type_name }.hash);
+    return reflector<T>(&ctx, internal::alias<T>{ type_name }.hash());
 }
 
 /**
  * @brief Begins capturing a new type in a local context. Returns a reflector to be used in a builder pattern.
  * @tparam T The type to capture.
  * @param type_name The name to associate with T.
+ * @throws reflection_error if the global context has been frozen.
  * @return An instance of a reflector, used to sequentially capture a new type.
  */
 template <typename T>
-auto capture(const char* type_name) noexcept -> reflector<T>
+auto capture(const char* type_name) -> reflector<T>
 {
-    return reflector<T>(&internal::global::ctx, internal::alias<T>{ type_name }.hash);
+    return reflector<T>(&internal::global::ctx, internal::alias<T>{ type_name }.hash());
 }
 
 /**
- * @brief Looks up and returns the type_handle associated with T.
- * @tparam T The type to lookup.
- * @throws reflection_error if the type T has not been captured.
- * @return The type_info associated with T.
+ * @brief Begins capturing a new type under the name the compiler spells it with, e.g. "ns::vec3". The name
+ * and its hash are computed at compile time.
+ * @tparam T The type to capture.
+ * @param ctx The context to capture into.
+ * @throws reflection_error if ctx has been frozen.
+ * @return An instance of a reflector, used to sequentially capture a new type.
  */
 template <typename T>
-auto lookup() -> type_handle
+auto capture(context& ctx) -> reflector<T>
 {
-    auto hash = internal::alias<T>::hash;
-    if (!hash) {
-        throw reflection_error{ "Hash does not exist for this type." };
-    }
-    auto& ctx = internal::global::ctx;
-    auto it   = ctx.find(internal::alias<T>::hash);
-    if (it == ctx.end()) {
-        throw reflection_error{ "Attempted to lookup type that has not been captured." };
+    return reflector<T>(&ctx, internal::alias<T>{ }.hash());
+}
+
+/**
+ * @brief Begins capturing a new type in the global context under the name the compiler spells it with.
+ * @tparam T The type to capture.
+ * @throws reflection_error if the global context has been frozen.
+ * @return An instance of a reflector, used to sequentially capture a new type.
+ */
+template <typename T>
+auto capture() -> reflector<T>
+{
+    return reflector<T>(&internal::global::ctx, internal::alias<T>{ }.hash());
+}
+
+/**
+ * @brief Begins capturing the enumerators of E. Returns an enum_reflector to be used in a builder pattern.
+ * @tparam E The enum to capture.
+ * @param ctx The context to capture into.
+ * @param type_name The name to associate with E.
+ * @throws reflection_error if ctx has been frozen.
+ * @return An instance of an enum_reflector, used to add enumerators.
+ */
+template <typename E>
+    requires std::is_enum_v<E>
+auto capture_enum(context& ctx, const char* type_name) -> enum_reflector<E>
+{
+    return enum_reflector<E>(&ctx, internal::alias<E>{ type_name }.hash());
+}
+
+/**
+ * @brief Begins capturing the enumerators of E in the global context.
+ * @tparam E The enum to capture.
+ * @param type_name The name to associate with E.
+ * @throws reflection_error if the global context has been frozen.
+ * @return An instance of an enum_reflector, used to add enumerators.
+ */
+template <typename E>
+    requires std::is_enum_v<E>
+auto capture_enum(const char* type_name) -> enum_reflector<E>
+{
+    return enum_reflector<E>(&internal::global::ctx, internal::alias<E>{ type_name }.hash());
+}
+
+/**
+ * @brief Begins capturing the enumerators of E under the name the compiler spells it with.
+ * @tparam E The enum to capture.
+ * @param ctx The context to capture into.
+ * @throws reflection_error if ctx has been frozen.
+ * @return An instance of an enum_reflector, used to add enumerators.
+ */
+template <typename E>
+    requires std::is_enum_v<E>
+auto capture_enum(context& ctx) -> enum_reflector<E>
+{
+    return enum_reflector<E>(&ctx, internal::alias<E>{ }.hash());
+}
+
+/**
+ * @brief Begins capturing the enumerators of E in the global context under the name the compiler spells it with.
+ * @tparam E The enum to capture.
+ * @throws reflection_error if the global context has been frozen.
+ * @return An instance of an enum_reflector, used to add enumerators.
+ */
+template <typename E>
+    requires std::is_enum_v<E>
+auto capture_enum() -> enum_reflector<E>
+{
+    return enum_reflector<E>(&internal::global::ctx, internal::alias<E>{ }.hash());
+}
+
+namespace internal
+{
+/**
+ * @throws reflection_error if E has not been captured into ctx through capture_enum().
+ */
+template <typename E>
+auto enumerators_of(const context& ctx) -> const enum_table&
+{
+    const type_descriptor* desc = ctx.find(alias<E>::index.load(std::memory_order_acquire));
+    if (!desc || !desc->enumerators) {
+        throw reflection_error{ "Attempted to convert an enum that has not been captured." };
     }
-    return type_handle{ &ctx, &it->second };
+    return *desc->enumerators;
+}
+} // namespace internal
+
+/**
+ * @brief Returns the name of the enumerator value, in constant time and without allocating.
+ * @param ctx The context source.
+ * @param value The value to convert.
+ * @throws reflection_error if E has not been captured through capture_enum().
+ * @return The name of value, or nullptr if no enumerator of E has been captured with it.
+ */
+template <typename E>
+    requires std::is_enum_v<E>
+auto enum_name(const context& ctx, const E value) -> const char*
+{
+    const auto underlying = static_cast<std::underlying_type_t<E>>(value);
+    return internal::enumerators_of<E>(ctx).name_of(static_cast<int64_t>(underlying));
+}
+
+template <typename E>
+    requires std::is_enum_v<E>
+auto enum_name(const E value) -> const char*
+{
+    return enum_name(internal::global::ctx, value);
+}
+
+/**
+ * @brief Returns the enumerator called name, in constant time and without allocating.
+ * @param ctx The context source.
+ * @param name The name to convert, which need not be null terminated.
+ * @throws reflection_error if E has not been captured through capture_enum().
+ * @return The enumerator, or nothing if no enumerator of E has been captured under name.
+ */
+template <typename E>
+    requires std::is_enum_v<E>
+auto enum_value(const context& ctx, const std::string_view name) -> std::optional<E>
+{
+    const auto* found = internal::enumerators_of<E>(ctx).find(name);
+    if (!found) return std::nullopt;
+    return static_cast<E>(static_cast<std::underlying_type_t<E>>(found->value));
+}
+
+template <typename E>
+    requires std::is_enum_v<E>
+auto enum_value(const std::string_view name) -> std::optional<E>
+{
+    return enum_value<E>(internal::global::ctx, name);
 }
 
 /**
@@ -73,15 +208,41 @@ auto lookup() -> type_handle
 template <typename T>
 auto lookup(const context& ctx) -> type_handle
 {
-    auto hash = internal::alias<T>::hash;
-    if (!hash) {
-        throw reflection_error{ "Hash does not exist for this type." };
+    // the dense index avoids hashing entirely, it is out of bounds for types never captured
+    auto* desc = ctx.find(internal::alias<T>::index.load(std::memory_order_acquire));
+    if (!desc) {
+        throw reflection_error{ "Attempted to lookup type that has not been captured." };
     }
-    auto it = ctx.find(hash);
-    if (it == ctx.end()) {
+    return type_handle{ &ctx, desc };
+}
+
+/**
+ * @brief Looks up and returns the type_handle associated with T.
+ * @tparam T The type to lookup.
+ * @throws reflection_error if the type T has not been captured.
+ * @return The type_info associated with T.
+ */
+template <typename T>
+auto lookup() -> type_handle
+{
+    return lookup<T>(internal::global::ctx);
+}
+
+/**
+ * @brief Looks up and returns the type_handle associated with T in a pinned version of a versioned_context.
+ * @tparam T The type to lookup.
+ * @param snap The pinned version, the returned handle keeps it alive.
+ * @throws reflection_error if the type T has not been captured.
+ * @return The type_info associated with T from the pinned version.
+ */
+template <typename T>
+auto lookup(const snapshot& snap) -> type_handle
+{
+    auto* desc = snap->find(internal::alias<T>::index.load(std::memory_order_acquire));
+    if (!desc) {
         throw reflection_error{ "Attempted to lookup type that has not been captured." };
     }
-    return type_handle{ &ctx, &it->second };
+    return type_handle{ &snap.get(), desc, snap.pin() };
 }
 
 /**
@@ -90,16 +251,25 @@ auto lookup(const context& ctx) -> type_handle
  * @throws reflection_error if the type has not been captured.
  * @return The type_info associated with the name.
  */
-inline auto lookup(const char* name) -> type_handle
+inline auto lookup(const hashed_string& name) -> type_handle
 {
-    auto& ctx     = internal::global::ctx;
-    const auto it = ctx.find(hashed_string{ name });
-    if (it == ctx.end()) {
+    auto& ctx  = internal::global::ctx;
+    auto* desc = ctx.find(name);
+    if (!desc) {
         throw reflection_error{ "Attempted to lookup type that has not been captured." };
     }
-    return type_handle{ &ctx, &it->second };
+    return type_handle{ &ctx, desc };
 }
 
+/**
+ * @brief Looks up and returns the type_info associated with the name, hashing it on every call. Prefer
+ * lookup("name"_hs) for literal names, which are hashed at compile time.
+ * @param name The name to lookup.
+ * @throws reflection_error if the type has not been captured.
+ * @return The type_info associated with the name.
+ */
+inline auto lookup(const char* name) -> type_handle { return lookup(hashed_string{ name }); }
+
 /**
  * @brief Looks up and returns the type_info associated with the name.
  * @param ctx The context source.
@@ -107,13 +277,50 @@ inline auto lookup(const char* name) -> type_handle
  * @throws reflection_error if the type has not been captured.
  * @return The type_info associated with the name.
  */
-inline auto lookup(context& ctx, const char* name) -> type_handle
+inline auto lookup(const context& ctx, const hashed_string& name) -> type_handle
 {
-    const auto it = ctx.find(hashed_string{ name });
-    if (it == ctx.end()) {
+    auto* desc = ctx.find(name);
+    if (!desc) {
         throw reflection_error{ "Attempted to lookup type that has not been captured." };
     }
-    return type_handle{ &ctx, &it->second };
+    return type_handle{ &ctx, desc };
+}
+
+inline auto lookup(const context& ctx, const char* name) -> type_handle { return lookup(ctx, hashed_string{ name }); }
+
+/**
+ * @brief Looks up and returns the type_info associated with the name in a pinned version of a versioned_context.
+ * @param snap The pinned version, the returned handle keeps it alive.
+ * @param name The name to lookup.
+ * @throws reflection_error if the type has not been captured.
+ * @return The type_info associated with the name.
+ */
+inline auto lookup(const snapshot& snap, const hashed_string& name) -> type_handle
+{
+    auto* desc = snap->find(name);
+    if (!desc) {
+        throw reflection_error{ "Attempted to lookup type that has not been captured." };
+    }
+    return type_handle{ &snap.get(), desc, snap.pin() };
+}
+
+inline auto lookup(const snapshot& snap, const char* name) -> type_handle
+{
+    return lookup(snap, hashed_string{ name });
+}
+
+/**
+ * @brief Returns a field_handle for every field captured in ctx which matches filter.
+ * @param ctx The context source, its field_table() is scanned.
+ * @param filter The criteria to match, e.g. field_filter{ }.of_type<float>().with_attribute(hashed_string{ "max" }).
+ * @return The matching fields, across all types.
+ */
+inline auto find_fields(const context& ctx, const field_filter& filter) -> std::vector<field_handle>
+{
+    const reflex::field_table& table = ctx.field_table();
+    std::vector<field_handle> fields;
+    table.for_each(filter, [&](const size_t row) { fields.emplace_back(&ctx, table.field(row)); });
+    return fields;
 }
 
 /**
@@ -0,0 +1,167 @@
+/**
+ * @file serialize.hpp
+ * @brief Binary serialization of captured types, driven by their type_descriptor.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <span>
+#include <type_traits>
+#include "alias.hpp"
+#include "context.hpp"
+#include "copy_plan.hpp"
+#include "exception.hpp"
+
+
+namespace reflex
+{
+namespace internal
+{
+/**
+ * @brief The cached copy plan of T in ctx.
+ * @throws reflection_error if T has not been captured into ctx or cannot be serialized.
+ */
+template <typename T>
+auto serialization_plan(const context& ctx) -> const copy_plan&
+{
+    const type_descriptor* desc = ctx.find(alias<T>::index.load(std::memory_order_acquire));
+    if (!desc) throw reflection_error{ "Attempted to serialize type that has not been captured." };
+
+    const copy_plan& plan = ctx.plan_of(*desc);
+    if (!plan.complete) {
+        throw reflection_error{ "Cannot serialize a field which is neither captured nor trivially copyable." };
+    }
+    return plan;
+}
+
+/// @brief Whether plan covers every byte of a T, in which case arrays of T are a single memcpy.
+template <typename T>
+auto covers_object(const copy_plan& plan) noexcept -> bool
+{
+    return std::is_trivially_copyable_v<T> &&
+           plan.runs.size() == 1 &&
+           plan.runs.front().offset == 0 &&
+           plan.runs.front().size == sizeof(T);
+}
+} // namespace internal
+
+
+/**
+ * @brief Writes captured objects into a caller provided buffer.
+ *
+ * Objects are written field by field in capture order without padding, recursing into fields whose type
+ * has been captured. The cached copy plan of the type (see context::plan_of()) coalesces adjacent trivially
+ * copyable fields into single memcpy runs, so writing a span of objects never allocates.
+ */
+class binary_writer
+{
+public:
+    binary_writer(const context& ctx, const std::span<std::byte> buffer) : m_ctx(&ctx), m_buffer(buffer) { }
+
+    /**
+     * @brief Appends obj to the buffer.
+     * @throws reflection_error if T cannot be serialized or the buffer is too small.
+     */
+    template <typename T>
+    auto write(const T& obj) -> void { write(std::span<const T, 1>{ &obj, 1 }); }
+
+    /**
+     * @brief Appends every object of objs to the buffer.
+     * @throws reflection_error if T cannot be serialized or the buffer is too small.
+     */
+    template <typename E, size_t Extent>
+    auto write(const std::span<E, Extent> objs) -> void
+    {
+        using T               = std::remove_const_t<E>;
+        const copy_plan& plan = internal::serialization_plan<T>(*m_ctx);
+        const size_t stride   = plan.bytes;
+        std::byte* out        = reserve(stride * objs.size());
+
+        if (internal::covers_object<T>(plan)) {
+            std::memcpy(out, objs.data(), stride * objs.size());
+            return;
+        }
+        for (const T& obj : objs) {
+            const auto* in = reinterpret_cast<const std::byte*>(&obj);
+            for (const copy_run& run : plan.runs) {
+                std::memcpy(out, in + run.offset, run.size);
+                out += run.size;
+            }
+        }
+    }
+
+    /// @brief The number of bytes written so far.
+    [[nodiscard]] auto size() const noexcept -> size_t { return m_size; }
+    [[nodiscard]] auto data() const noexcept -> std::span<std::byte> { return m_buffer.first(m_size); }
+
+private:
+    auto reserve(const size_t bytes) -> std::byte*
+    {
+        if (m_buffer.size() - m_size < bytes) throw reflection_error{ "binary_writer buffer is too small." };
+        std::byte* out = m_buffer.data() + m_size;
+        m_size += bytes;
+        return out;
+    }
+
+    const context* m_ctx;
+    std::span<std::byte> m_buffer;
+    size_t m_size = 0;
+};
+
+/**
+ * @brief Reads objects written by a binary_writer back into existing objects.
+ */
+class binary_reader
+{
+public:
+    binary_reader(const context& ctx, const std::span<const std::byte> buffer) : m_ctx(&ctx), m_buffer(buffer) { }
+
+    /**
+     * @brief Reads the next object into obj.
+     * @throws reflection_error if T cannot be serialized or the buffer is exhausted.
+     */
+    template <typename T>
+    auto read(T& obj) -> void { read(std::span<T, 1>{ &obj, 1 }); }
+
+    /**
+     * @brief Reads the next objs.size() objects into objs.
+     * @throws reflection_error if T cannot be serialized or the buffer is exhausted.
+     */
+    template <typename T, size_t Extent>
+    auto read(const std::span<T, Extent> objs) -> void
+    {
+        const copy_plan& plan = internal::serialization_plan<T>(*m_ctx);
+        const size_t stride   = plan.bytes;
+        const std::byte* in   = consume(stride * objs.size());
+
+        if (internal::covers_object<T>(plan)) {
+            std::memcpy(objs.data(), in, stride * objs.size());
+            return;
+        }
+        for (T& obj : objs) {
+            auto* out = reinterpret_cast<std::byte*>(&obj);
+            for (const copy_run& run : plan.runs) {
+                std::memcpy(out + run.offset, in, run.size);
+                in += run.size;
+            }
+        }
+    }
+
+    /// @brief The number of bytes read so far.
+    [[nodiscard]] auto size() const noexcept -> size_t { return m_size; }
+
+private:
+    auto consume(const size_t bytes) -> const std::byte*
+    {
+        if (m_buffer.size() - m_size < bytes) throw reflection_error{ "binary_reader buffer is exhausted." };
+        const std::byte* in = m_buffer.data() + m_size;
+        m_size += bytes;
+        return in;
+    }
+
+    const context* m_ctx;
+    std::span<const std::byte> m_buffer;
+    size_t m_size = 0;
+};
+} // namespace reflex
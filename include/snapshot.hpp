@@ -0,0 +1,138 @@
+/**
+ * @file snapshot.hpp
+ * @brief Immutable context versions published with an atomic swap, for hot reloading type definitions.
+ */
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include "context.hpp"
+#include "epoch.hpp"
+#include "hashed_string.hpp"
+
+
+namespace reflex
+{
+/**
+ * @brief A pinned, immutable version of a versioned_context.
+ *
+ * The version stays alive for as long as any snapshot or handle obtained through it does, even after
+ * newer versions have been published. Snapshots are cheap to copy but must stay on the thread which
+ * pinned them, see internal::epoch_guard.
+ */
+class snapshot
+{
+public:
+    snapshot(const context* ctx, internal::epoch_guard pin) : m_ctx(ctx), m_pin(std::move(pin)) { }
+
+    [[nodiscard]] auto get() const noexcept -> const context& { return *m_ctx; }
+    auto operator->() const noexcept -> const context* { return m_ctx; }
+
+    /// @brief The pin keeping this version alive, shared with handles obtained through it.
+    [[nodiscard]] auto pin() const noexcept -> const internal::epoch_guard& { return m_pin; }
+
+private:
+    const context* m_ctx;
+    internal::epoch_guard m_pin;
+};
+
+/**
+ * @brief A context which is replaced as a whole whenever a type definition changes.
+ *
+ * Types are defined through recipes, functions capturing into a context. Each change replays every
+ * recipe into a new context, freezes it and publishes it with a single atomic pointer swap. Readers pin
+ * the current version without taking any lock, and older versions are destroyed through the epoch domain
+ * once the last reader has let go of them.
+ *
+ * @code
+ * reflex::versioned_context types;
+ * types.define("pos", [](reflex::context& ctx) { reflex::capture<pos>(ctx, "pos").field<&pos::x>("x"); });
+ * const reflex::snapshot snap = types.pin();
+ * const reflex::type_handle pos_type = reflex::lookup<pos>(snap);
+ * @endcode
+ */
+class versioned_context
+{
+public:
+    using recipe = std::function<void(context&)>;
+
+    versioned_context() : m_current(make_frozen(context{ }))
+    {
+        // constructed first, the domain is destroyed last, so a static versioned_context can still retire into it
+        static_cast<void>(internal::epoch_domain::instance());
+    }
+
+    versioned_context(const versioned_context&)                    = delete;
+    auto operator=(const versioned_context&) -> versioned_context& = delete;
+
+    ~versioned_context() { retire(m_current.load(std::memory_order_relaxed)); }
+
+    /**
+     * @brief Pins the current version. Wait free, it never blocks on writers.
+     */
+    [[nodiscard]] auto pin() const -> snapshot
+    {
+        internal::epoch_guard guard = internal::epoch_guard::pin();
+        return snapshot{ m_current.load(std::memory_order_acquire), std::move(guard) };
+    }
+
+    /**
+     * @brief Adds the recipe stored under key, or replaces it if key has been defined before, then
+     * publishes a new version.
+     * @throws Whatever any recipe throws, in which case the current version stays published.
+     */
+    auto define(const hashed_string& key, recipe fn) -> void
+    {
+        const std::scoped_lock lock{ m_mutex };
+        auto recipes        = m_recipes;
+        const auto existing = std::ranges::find(recipes, key.value(), &std::pair<uint64_t, recipe>::first);
+        if (existing != recipes.end()) {
+            existing->second = std::move(fn);
+        } else {
+            recipes.emplace_back(key.value(), std::move(fn));
+        }
+        publish(recipes);
+        m_recipes = std::move(recipes);
+    }
+
+    /**
+     * @brief The number of versions published so far, starting at 1 for the initial empty version.
+     */
+    [[nodiscard]] auto version() const noexcept -> uint64_t { return m_version.load(std::memory_order_relaxed); }
+
+private:
+    static auto make_frozen(context ctx) -> const context*
+    {
+        ctx.freeze();
+        return new context{ std::move(ctx) };
+    }
+
+    static auto retire(const context* ctx) -> void
+    {
+        internal::epoch_domain::instance().retire(const_cast<context*>(ctx), [](void* object) {
+            delete static_cast<context*>(object);
+        });
+    }
+
+    auto publish(const std::vector<std::pair<uint64_t, recipe>>& recipes) -> void
+    {
+        context next;
+        for (const auto& [key, fn] : recipes) fn(next);
+        const context* previous = m_current.exchange(make_frozen(std::move(next)), std::memory_order_acq_rel);
+        m_version.fetch_add(1, std::memory_order_relaxed);
+        retire(previous);
+    }
+
+    std::atomic<const context*> m_current;
+    std::atomic<uint64_t> m_version{ 1 };
+    /// @brief Serializes writers, readers never touch it.
+    std::mutex m_mutex;
+    std::vector<std::pair<uint64_t, recipe>> m_recipes;
+};
+} // namespace reflex
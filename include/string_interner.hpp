@@ -0,0 +1,146 @@
+/**
+ * @file string_interner.hpp
+ * @brief Owning, deduplicated storage for the names captured into a context.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include "arena.hpp"
+#include "flat_table.hpp"
+#include "hashed_string.hpp"
+
+
+namespace reflex
+{
+namespace internal
+{
+class string_interner;
+}
+
+/**
+ * @brief A name owned by the string_interner of a context, which copied it on capture.
+ *
+ * Holds the hash and the interned characters in 16 bytes where a hashed_string takes 24, the length is
+ * stored by the interner in front of the characters. Compares like a hashed_string, by hash.
+ */
+class interned_string
+{
+public:
+    constexpr interned_string() noexcept = default;
+
+    [[nodiscard]] constexpr auto value() const noexcept -> uint64_t { return m_hash; }
+
+    /**
+     * @brief Returns the interned, null terminated characters, valid as long as the owning context.
+     */
+    [[nodiscard]] constexpr auto data() const noexcept -> const char* { return m_name; }
+
+    [[nodiscard]] auto length() const noexcept -> size_t
+    {
+        if (!m_name) return 0;
+        uint32_t length;
+        std::memcpy(&length, m_name - sizeof(uint32_t), sizeof(uint32_t));
+        return length;
+    }
+
+    /**
+     * @brief Compares the strings behind both hashes, see hashed_string::same_string().
+     */
+    [[nodiscard]] auto same_string(const hashed_string& other) const noexcept -> bool
+    {
+        return hashed_string{ *this }.same_string(other);
+    }
+
+    [[nodiscard]] constexpr auto operator==(const interned_string& other) const noexcept -> bool
+    {
+        return m_hash == other.m_hash;
+    }
+
+    [[nodiscard]] constexpr auto operator==(const hashed_string& other) const noexcept -> bool
+    {
+        return m_hash == other.value();
+    }
+
+    [[nodiscard]] explicit operator bool() const noexcept { return m_hash != 0; }
+
+    /**
+     * @brief Implicit, so an interned name can be looked up wherever a hashed_string is expected.
+     */
+    operator hashed_string() const noexcept { return hashed_string{ m_hash, m_name, length() }; }
+
+private:
+    friend class internal::string_interner;
+
+    constexpr interned_string(const uint64_t hash, const char* name) noexcept : m_hash(hash), m_name(name) { }
+
+    uint64_t m_hash    = 0;
+    const char* m_name = nullptr;
+};
+
+namespace internal
+{
+/**
+ * @brief Copies names into a character arena of their own, each distinct name once.
+ *
+ * Names are indexed by their hash, so capturing a name already interned, be it a type, a field, a method or
+ * the type of a field, copies nothing. Of several names sharing a hash only the first one is deduplicated,
+ * the others each get a copy of their own. Chunks never move, interned names stay valid while more are
+ * added and until the interner is destroyed. Not synchronized, see context::lock_storage().
+ */
+class string_interner
+{
+public:
+    /**
+     * @brief Returns the interned copy of name. A name without any string interns to its hash alone.
+     */
+    auto intern(const hashed_string& name) -> interned_string
+    {
+        if (!name.data()) return interned_string{ name.value(), nullptr };
+        if (const char* const* existing = m_index.find(name.value())) {
+            const interned_string found{ name.value(), *existing };
+            return found.same_string(name) ? found : copy(name);
+        }
+        const interned_string copied = copy(name);
+        m_index.emplace(name.value(), copied.data());
+        return copied;
+    }
+
+    /// @brief The number of distinct names interned.
+    [[nodiscard]] auto size() const noexcept -> size_t { return m_index.size(); }
+    /// @brief The bytes taken by interned names, including their lengths and terminators.
+    [[nodiscard]] auto bytes() const noexcept -> size_t { return m_chars.bytes_allocated(); }
+
+private:
+    auto copy(const hashed_string& name) -> interned_string
+    {
+        const auto length = static_cast<uint32_t>(name.length());
+        auto* block       = static_cast<char*>(m_chars.allocate(sizeof(uint32_t) + length + 1, alignof(uint32_t)));
+        std::memcpy(block, &length, sizeof(uint32_t));
+        char* chars = block + sizeof(uint32_t);
+        std::memcpy(chars, name.data(), length);
+        chars[length] = '\0';
+        return interned_string{ name.value(), chars };
+    }
+
+    arena m_chars;
+    /// @brief The characters of the first name interned under each hash.
+    flat_table<const char*> m_index;
+};
+
+/**
+ * @brief Interns name for the rest of the program, for names held by process wide state such as the name
+ * alias<T> keeps for T, which every context captures T under.
+ */
+inline auto intern_static(const hashed_string& name) -> hashed_string
+{
+    // never destroyed, so names stay readable while other statics are torn down
+    static auto* names = new string_interner{ };
+    static std::mutex mutex;
+    const std::scoped_lock lock{ mutex };
+    return names->intern(name);
+}
+} // namespace internal
+} // namespace reflex
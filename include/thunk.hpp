@@ -0,0 +1,77 @@
+/**
+ * @file thunk.hpp
+ * @brief Type erased trampolines calling member functions with arguments passed by address.
+ */
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "traits.hpp"
+
+
+namespace reflex::internal
+{
+/**
+ * @brief Calls a member function on obj.
+ * @param args The address of every argument in declaration order.
+ * @param ret Uninitialized storage the return value is constructed into, or nullptr to discard it. A
+ * returned reference is stored as a pointer to the object it refers to.
+ */
+using method_thunk = void (*)(void* obj, void* const* args, void* ret);
+
+/// @brief Passes the argument at arg on as Arg, by value parameters copy it and only rvalue references move it.
+template <typename Arg>
+auto unpack(void* const arg) noexcept -> decltype(auto)
+{
+    using value_type = std::remove_reference_t<Arg>;
+    if constexpr (std::is_rvalue_reference_v<Arg>) {
+        return std::move(*static_cast<value_type*>(arg));
+    } else {
+        return *static_cast<value_type*>(arg);
+    }
+}
+
+template <auto Ptr, typename... Args, size_t... I>
+auto call_with(void* const obj, void* const* const args, void* const ret, std::index_sequence<I...>) -> void
+{
+    using info        = method_info<decltype(Ptr)>;
+    using return_type = typename info::return_type;
+    auto& self        = *static_cast<typename info::class_type*>(obj);
+
+    const auto call = [&]() -> decltype(auto) {
+        if constexpr (info::is_rvalue) {
+            return (std::move(self).*Ptr)(unpack<Args>(args[I])...);
+        } else {
+            return (self.*Ptr)(unpack<Args>(args[I])...);
+        }
+    };
+
+    if constexpr (std::is_void_v<return_type>) {
+        call();
+    } else if (!ret) {
+        (void)call();
+    } else if constexpr (std::is_reference_v<return_type>) {
+        auto&& result = call();
+        ::new (ret) std::add_pointer_t<return_type>(std::addressof(result));
+    } else {
+        ::new (ret) return_type(call());
+    }
+}
+
+/**
+ * @brief The trampoline of Ptr, a plain function so each call costs one indirect call and no allocation.
+ */
+template <auto Ptr>
+    requires member_function_ptr<Ptr>
+auto thunk(void* obj, void* const* args, void* ret) -> void
+{
+    using arguments = typename method_info<decltype(Ptr)>::arguments;
+    [&]<typename... Args>(std::type_identity<std::tuple<Args...>>) {
+        call_with<Ptr, Args...>(obj, args, ret, std::index_sequence_for<Args...>{ });
+    }(std::type_identity<arguments>{ });
+}
+} // namespace reflex::internal
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <tuple>
 #include <type_traits>
 
 
@@ -22,6 +23,10 @@ concept static_field_ptr =
 template <auto Ptr>
 concept field_ptr = member_field_ptr<Ptr> || static_field_ptr<Ptr>;
 
+/// @brief A non static member function pointer.
+template <auto Ptr>
+concept member_function_ptr = std::is_member_function_pointer_v<decltype(Ptr)>;
+
 /// @brief Helper type alias template to strip volatile/const/&/* from types.
 template <typename T>
 using stripped_type = std::remove_cvref_t<std::remove_pointer_t<T>>;
@@ -36,4 +41,73 @@ struct member_info<T C::*>
     using class_type = C;
 };
 
+/**
+ * @brief What method_info reports of a member function, whatever its qualifiers.
+ * @tparam Const Whether the method may be called on a const object.
+ * @tparam Rvalue Whether the method is && qualified, so it must be called on an rvalue.
+ */
+template <typename C, typename R, bool Const, bool Rvalue, typename... Args>
+struct method_signature
+{
+    using class_type  = C;
+    using return_type = R;
+    using arguments   = std::tuple<Args...>;
+
+    static constexpr bool is_const  = Const;
+    static constexpr bool is_rvalue = Rvalue;
+};
+
+template <typename T>
+struct method_info;
+
+template <typename C, typename R, typename... Args>
+struct method_info<R (C::*)(Args...)> : method_signature<C, R, false, false, Args...> { };
+template <typename C, typename R, typename... Args>
+struct method_info<R (C::*)(Args...) const> : method_signature<C, R, true, false, Args...> { };
+template <typename C, typename R, typename... Args>
+struct method_info<R (C::*)(Args...) volatile> : method_signature<C, R, false, false, Args...> { };
+template <typename C, typename R, typename... Args>
+struct method_info<R (C::*)(Args...) const volatile> : method_signature<C, R, true, false, Args...> { };
+template <typename C, typename R, typename... Args>
+struct method_info<R (C::*)(Args...) &> : method_signature<C, R, false, false, Args...> { };
+template <typename C, typename R, typename... Args>
+struct method_info<R (C::*)(Args...) const &> : method_signature<C, R, true, false, Args...> { };
+template <typename C, typename R, typename... Args>
+struct method_info<R (C::*)(Args...) volatile &> : method_signature<C, R, false, false, Args...> { };
+template <typename C, typename R, typename... Args>
+struct method_info<R (C::*)(Args...) const volatile &> : method_signature<C, R, true, false, Args...> { };
+template <typename C, typename R, typename... Args>
+struct method_info<R (C::*)(Args...) &&> : method_signature<C, R, false, true, Args...> { };
+template <typename C, typename R, typename... Args>
+struct method_info<R (C::*)(Args...) const &&> : method_signature<C, R, true, true, Args...> { };
+template <typename C, typename R, typename... Args>
+struct method_info<R (C::*)(Args...) volatile &&> : method_signature<C, R, false, true, Args...> { };
+template <typename C, typename R, typename... Args>
+struct method_info<R (C::*)(Args...) const volatile &&> : method_signature<C, R, true, true, Args...> { };
+
+template <typename C, typename R, typename... Args>
+struct method_info<R (C::*)(Args...) noexcept> : method_signature<C, R, false, false, Args...> { };
+template <typename C, typename R, typename... Args>
+struct method_info<R (C::*)(Args...) const noexcept> : method_signature<C, R, true, false, Args...> { };
+template <typename C, typename R, typename... Args>
+struct method_info<R (C::*)(Args...) volatile noexcept> : method_signature<C, R, false, false, Args...> { };
+template <typename C, typename R, typename... Args>
+struct method_info<R (C::*)(Args...) const volatile noexcept> : method_signature<C, R, true, false, Args...> { };
+template <typename C, typename R, typename... Args>
+struct method_info<R (C::*)(Args...) & noexcept> : method_signature<C, R, false, false, Args...> { };
+template <typename C, typename R, typename... Args>
+struct method_info<R (C::*)(Args...) const & noexcept> : method_signature<C, R, true, false, Args...> { };
+template <typename C, typename R, typename... Args>
+struct method_info<R (C::*)(Args...) volatile & noexcept> : method_signature<C, R, false, false, Args...> { };
+template <typename C, typename R, typename... Args>
+struct method_info<R (C::*)(Args...) const volatile & noexcept> : method_signature<C, R, true, false, Args...> { };
+template <typename C, typename R, typename... Args>
+struct method_info<R (C::*)(Args...) && noexcept> : method_signature<C, R, false, true, Args...> { };
+template <typename C, typename R, typename... Args>
+struct method_info<R (C::*)(Args...) const && noexcept> : method_signature<C, R, true, true, Args...> { };
+template <typename C, typename R, typename... Args>
+struct method_info<R (C::*)(Args...) volatile && noexcept> : method_signature<C, R, false, true, Args...> { };
+template <typename C, typename R, typename... Args>
+struct method_info<R (C::*)(Args...) const volatile && noexcept> : method_signature<C, R, true, true, Args...> { };
+
 } // namespace reflex
@@ -0,0 +1,118 @@
+/**
+ * @file type_name.hpp
+ * @brief Compile time type names deduced from the compiler's pretty function signature.
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+
+namespace reflex::internal
+{
+template <typename T>
+constexpr auto raw_type_name() noexcept -> std::string_view
+{
+#if defined(__clang__) || defined(__GNUC__)
+    return __PRETTY_FUNCTION__;
+#elif defined(_MSC_VER)
+    return __FUNCSIG__;
+#else
+#error "reflex: type name deduction is not supported on this compiler"
+#endif
+}
+
+// The signature of a known type tells us how much decoration surrounds the type name on this compiler.
+constexpr std::string_view type_name_probe = raw_type_name<int>();
+constexpr size_t type_name_prefix          = type_name_probe.rfind("int");
+constexpr size_t type_name_suffix          = type_name_probe.size() - type_name_prefix - 3;
+
+template <typename T>
+constexpr auto type_name_view() noexcept -> std::string_view
+{
+    std::string_view name = raw_type_name<T>();
+    name.remove_prefix(type_name_prefix);
+    name.remove_suffix(type_name_suffix);
+    // msvc spells out the class key of user defined types
+    for (const std::string_view key : { "struct ", "class ", "union ", "enum " }) {
+        if (name.starts_with(key)) name.remove_prefix(key.size());
+    }
+    return name;
+}
+
+/// @brief Null terminated storage for the deduced name of T.
+template <typename T>
+struct type_name_storage
+{
+    static constexpr std::string_view view = type_name_view<T>();
+
+    static constexpr auto value = [] {
+        std::array<char, view.size() + 1> str{ };
+        for (size_t i = 0; i < view.size(); ++i) str[i] = view[i];
+        return str;
+    }();
+};
+
+/**
+ * @brief The name of T as spelled by the compiler, e.g. "pos_component" or "ns::vec3".
+ */
+template <typename T>
+constexpr auto type_name() noexcept -> const char*
+{
+    return type_name_storage<T>::value.data();
+}
+
+template <auto V>
+constexpr auto raw_value_name() noexcept -> std::string_view
+{
+#if defined(__clang__) || defined(__GNUC__)
+    return __PRETTY_FUNCTION__;
+#elif defined(_MSC_VER)
+    return __FUNCSIG__;
+#endif
+}
+
+enum class value_name_probe
+{
+    probe
+};
+
+// Enumerators are spelled with their enclosing scopes, so only the decoration after the value is fixed.
+constexpr std::string_view value_name_probe_signature = raw_value_name<value_name_probe::probe>();
+constexpr size_t value_name_suffix = value_name_probe_signature.size() - value_name_probe_signature.rfind("probe") - 5;
+
+template <auto V>
+constexpr auto value_name_view() noexcept -> std::string_view
+{
+    std::string_view name = raw_value_name<V>();
+    name.remove_suffix(value_name_suffix);
+    name.remove_prefix(name.find_last_of(" :)>=") + 1);
+    // values without an enumerator come out as a cast such as "(color)7"
+    if (name.empty() || (name.front() >= '0' && name.front() <= '9') || name.front() == '-') return { };
+    return name;
+}
+
+/// @brief Null terminated storage for the deduced enumerator name of V.
+template <auto V>
+struct value_name_storage
+{
+    static constexpr std::string_view view = value_name_view<V>();
+
+    static constexpr auto value = [] {
+        std::array<char, view.size() + 1> str{ };
+        for (size_t i = 0; i < view.size(); ++i) str[i] = view[i];
+        return str;
+    }();
+};
+
+/**
+ * @brief The unqualified name of the enumerator V, e.g. "green" for color::green, or an empty string if
+ * no enumerator has the value V.
+ */
+template <auto V>
+constexpr auto value_name() noexcept -> const char*
+{
+    return value_name_storage<V>::value.data();
+}
+} // namespace reflex::internal
@@ -2,4 +2,1237 @@
 #include "doctest.h"
 #include "reflex.hpp"
 
-// atm this just solves clion indexing issues, but tests to come!
\ No newline at end of file
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <iterator>
+#include <numeric>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+TEST_CASE("context stores and finds descriptors by hash")
+{
+    reflex::context ctx;
+    const reflex::hashed_string hash{ "vec3" };
+
+    auto [desc, inserted] = ctx.emplace(hash, reflex::internal::type_descriptor{ { }, 12, { } });
+    CHECK(inserted);
+    CHECK(ctx.find(hash) == desc);
+    CHECK(ctx.find(reflex::hashed_string{ "vec4" }) == nullptr);
+    CHECK_FALSE(ctx.emplace(hash, reflex::internal::type_descriptor{ { }, 16, { } }).second);
+    CHECK(ctx.at(hash).size == 12);
+    CHECK_THROWS_AS((void)ctx.at(reflex::hashed_string{ "vec4" }), reflex::reflection_error);
+}
+
+TEST_CASE("context descriptors stay put while the index grows")
+{
+    reflex::context ctx;
+    std::vector<std::string> names;
+    for (int i = 0; i < 5000; ++i) names.push_back("type_" + std::to_string(i));
+
+    std::vector<const reflex::internal::type_descriptor*> stored;
+    for (const auto& name : names) {
+        const reflex::hashed_string hash{ name.c_str() };
+        stored.push_back(ctx.emplace(hash, reflex::internal::type_descriptor{ { }, 4, { } }).first);
+    }
+
+    CHECK(ctx.size() == names.size());
+    for (size_t i = 0; i < names.size(); ++i) CHECK(ctx.find(reflex::hashed_string{ names[i].c_str() }) == stored[i]);
+}
+
+TEST_CASE("frozen context finds every type and rejects new captures")
+{
+    reflex::context ctx;
+    std::vector<std::string> names;
+    for (int i = 0; i < 1000; ++i) names.push_back("frozen_" + std::to_string(i));
+    for (size_t i = 0; i < names.size(); ++i) {
+        const reflex::hashed_string hash{ names[i].c_str() };
+        ctx.emplace(hash, reflex::internal::type_descriptor{ { }, i, { } });
+    }
+
+    ctx.freeze();
+    CHECK(ctx.frozen());
+    CHECK(ctx.size() == names.size());
+    for (size_t i = 0; i < names.size(); ++i) {
+        const auto* desc = ctx.find(reflex::hashed_string{ names[i].c_str() });
+        REQUIRE(desc != nullptr);
+        CHECK(desc->size == i);
+    }
+    CHECK(ctx.find(reflex::hashed_string{ "not_captured" }) == nullptr);
+
+    const reflex::hashed_string late{ "late" };
+    CHECK_THROWS_AS(ctx.emplace(late, reflex::internal::type_descriptor{ { }, 1, { } }), reflex::reflection_error);
+}
+
+TEST_CASE("freezing an empty context")
+{
+    reflex::context ctx;
+    ctx.freeze();
+    CHECK(ctx.empty());
+    CHECK(ctx.find(reflex::hashed_string{ "anything" }) == nullptr);
+}
+
+namespace
+{
+struct indexed_a
+{
+    int a;
+};
+
+struct indexed_b
+{
+    float b;
+};
+
+struct never_captured { };
+} // namespace
+
+TEST_CASE("lookup<T> resolves through the dense type index")
+{
+    reflex::context ctx;
+    reflex::capture<indexed_a>(ctx, "indexed_a");
+    reflex::capture<indexed_b>(ctx, "indexed_b");
+
+    CHECK(std::string{ reflex::lookup<indexed_a>(ctx).name() } == "indexed_a");
+    CHECK(std::string{ reflex::lookup<indexed_b>(ctx).name() } == "indexed_b");
+    CHECK(reflex::internal::alias<indexed_a>::index.load() != reflex::internal::alias<indexed_b>::index.load());
+    CHECK_THROWS_AS(reflex::lookup<never_captured>(ctx), reflex::reflection_error);
+
+    reflex::context other;
+    CHECK_THROWS_AS(reflex::lookup<indexed_a>(other), reflex::reflection_error);
+
+    ctx.freeze();
+    CHECK(std::string{ reflex::lookup<indexed_b>(ctx).name() } == "indexed_b");
+}
+
+namespace
+{
+struct decorated
+{
+    float value;
+};
+} // namespace
+
+TEST_CASE("attributes are typed and stored without std::any")
+{
+    reflex::context ctx;
+    reflex::capture<decorated>(ctx, "decorated")
+            .field<&decorated::value>("value")
+                .decorate("min", 1.f)
+                .decorate("max", 100.f)
+                .decorate("label", std::string{ "a rather long label which cannot fit inline" })
+                .decorate("min", 5.f);
+
+    const auto field = *reflex::lookup<decorated>(ctx).fields().begin();
+    CHECK(field.attribute<float>("min") == 1.f);
+    CHECK(field.attribute<float>("max") == 100.f);
+    CHECK(field.attribute<std::string>("label") == "a rather long label which cannot fit inline");
+    CHECK(&field.attribute<float>("max") == &field.attribute<float>("max"));
+
+    CHECK(field.has_attribute("min"));
+    CHECK_FALSE(field.has_attribute("step"));
+    CHECK(field.find_attribute<int>("min") == nullptr);
+    CHECK(field.find_attribute<float>("step") == nullptr);
+    CHECK_THROWS_AS((void)field.attribute<double>("max"), reflex::reflection_error);
+}
+
+namespace
+{
+struct recaptured
+{
+    float first;
+    float second;
+};
+} // namespace
+
+TEST_CASE("capturing a field name twice keeps the first field")
+{
+    reflex::context ctx;
+    reflex::capture<recaptured>(ctx, "recaptured")
+            .field<&recaptured::first>("value")
+                .decorate("min", 1.f)
+            .field<&recaptured::second>("value")
+                .decorate("max", 2.f);
+
+    const reflex::type_handle type = reflex::lookup<recaptured>(ctx);
+    CHECK(type.fields().size() == 1);
+    const reflex::field_handle field = type.field("value");
+    CHECK(field.offset() == offsetof(recaptured, first));
+    // decorating the repeated name attaches to the field it resolves to
+    CHECK(field.attribute<float>("min") == 1.f);
+    CHECK(field.attribute<float>("max") == 2.f);
+}
+
+namespace
+{
+struct meta_point
+{
+    int x;
+    int y;
+};
+} // namespace
+
+template <>
+struct reflex::meta<meta_point>
+{
+    static constexpr auto fields = std::tuple{
+        reflex::field<&meta_point::x>{ "x" },
+        reflex::field<&meta_point::y>{ "y" },
+    };
+};
+
+TEST_CASE("for_each_field walks the compile time field list")
+{
+    static_assert(reflex::field_count<meta_point> == 2);
+    static_assert([] {
+        meta_point p{ 3, 4 };
+        int sum = 0;
+        reflex::for_each_field(p, [&](const char*, int value) { sum += value; });
+        return sum;
+    }() == 7);
+
+    meta_point p{ 1, 2 };
+    std::string names;
+    reflex::for_each_field(p, [&](const char* name, int& value) {
+        names += name;
+        value *= 10;
+    });
+    CHECK(names == "xy");
+    CHECK(p.x == 10);
+    CHECK(p.y == 20);
+
+    reflex::context ctx;
+    reflex::capture<meta_point>(ctx, "meta_point").from_meta();
+    std::string captured;
+    for (const auto& field : reflex::lookup<meta_point>(ctx).fields()) captured += field.name();
+    CHECK(captured == "xy");
+}
+
+namespace
+{
+struct accessed
+{
+    int id;
+    double weight;
+};
+} // namespace
+
+TEST_CASE("field_handle reads and writes fields through their offset")
+{
+    reflex::context ctx;
+    reflex::capture<accessed>(ctx, "accessed").field<&accessed::id>("id").field<&accessed::weight>("weight");
+
+    const auto fields = reflex::lookup<accessed>(ctx).fields();
+    auto it           = fields.begin();
+    const auto id     = *it++;
+    const auto weight = *it;
+
+    accessed obj{ 7, 2.5 };
+    CHECK(id.get<int>(&obj) == 7);
+    CHECK(weight.get<double>(&obj) == 2.5);
+
+    weight.set(&obj, 4.0);
+    id.ref<int>(&obj) = 9;
+    CHECK(obj.weight == 4.0);
+    CHECK(obj.id == 9);
+    CHECK(weight.offset() == offsetof(accessed, weight));
+
+#ifndef NDEBUG
+    CHECK_THROWS_AS((void)weight.get<int>(&obj), reflex::reflection_error);
+#endif
+}
+
+namespace
+{
+struct ser_vec
+{
+    float x, y;
+};
+
+struct ser_body
+{
+    char tag;
+    ser_vec position;
+    double mass;
+};
+
+struct ser_named
+{
+    std::string name;
+};
+} // namespace
+
+TEST_CASE("binary_writer and binary_reader round trip nested types without padding")
+{
+    reflex::context ctx;
+    reflex::capture<ser_vec>(ctx, "ser_vec").field<&ser_vec::x>("x").field<&ser_vec::y>("y");
+    reflex::capture<ser_body>(ctx, "ser_body")
+            .field<&ser_body::tag>("tag")
+            .field<&ser_body::position>("position")
+            .field<&ser_body::mass>("mass");
+    reflex::capture<ser_named>(ctx, "ser_named").field<&ser_named::name>("name");
+
+    const std::vector<ser_body> bodies{ { 'a', { 1, 2 }, 3 }, { 'b', { 4, 5 }, 6 } };
+    std::vector<std::byte> buffer(64);
+
+    reflex::binary_writer writer{ ctx, buffer };
+    writer.write(std::span{ bodies });
+    CHECK(writer.size() == 2 * (sizeof(char) + 2 * sizeof(float) + sizeof(double)));
+
+    std::vector<ser_body> read(2);
+    reflex::binary_reader reader{ ctx, writer.data() };
+    reader.read(std::span{ read });
+    CHECK(read[1].tag == 'b');
+    CHECK(read[1].position.y == 5);
+    CHECK(read[1].mass == 6);
+    CHECK_THROWS_AS(reader.read(read[0]), reflex::reflection_error);
+
+    std::vector<std::byte> tiny(4);
+    reflex::binary_writer small{ ctx, tiny };
+    CHECK_THROWS_AS(small.write(bodies[0]), reflex::reflection_error);
+    CHECK_THROWS_AS(small.write(ser_named{ }), reflex::reflection_error);
+}
+
+namespace
+{
+struct plan_inner
+{
+    int a;
+    int b;
+};
+
+struct plan_outer
+{
+    char tag;
+    plan_inner inner;
+    short trailing;
+    std::string name;
+};
+} // namespace
+
+TEST_CASE("copy plans merge contiguous fields and skip padding")
+{
+    reflex::context ctx;
+    reflex::capture<plan_inner>(ctx, "plan_inner").field<&plan_inner::a>("a");
+    reflex::capture<plan_outer>(ctx, "plan_outer")
+            .field<&plan_outer::tag>("tag")
+            .field<&plan_outer::inner>("inner")
+            .field<&plan_outer::trailing>("trailing");
+
+    // inner's layout changes after outer's plan is cached, which must invalidate it
+    const auto& stale = reflex::lookup<plan_outer>(ctx).copy_plan();
+    CHECK(stale.runs.size() == 3);
+    reflex::capture<plan_inner>(ctx, "plan_inner").field<&plan_inner::b>("b");
+
+    const auto& plan = reflex::lookup<plan_outer>(ctx).copy_plan();
+    REQUIRE(plan.runs.size() == 2);
+    CHECK(plan.runs[0].offset == offsetof(plan_outer, tag));
+    CHECK(plan.runs[1].offset == offsetof(plan_outer, inner));
+    CHECK(plan.runs[1].size == 2 * sizeof(int) + sizeof(short));
+    CHECK(plan.bytes == sizeof(char) + 2 * sizeof(int) + sizeof(short));
+    CHECK(plan.complete);
+
+    reflex::capture<plan_outer>(ctx, "plan_outer").field<&plan_outer::name>("name");
+    CHECK_FALSE(reflex::lookup<plan_outer>(ctx).copy_plan().complete);
+
+    plan_outer src{ 'x', { 1, 2 }, 3, "skipped" };
+    plan_outer dst{ };
+    reflex::lookup<plan_outer>(ctx).copy_plan().copy(&dst, &src);
+    CHECK(dst.inner.b == 2);
+    CHECK(dst.trailing == 3);
+    CHECK(dst.name.empty());
+}
+
+namespace deduced
+{
+struct vec2
+{
+    float x;
+    float y;
+};
+
+struct renamed { };
+} // namespace deduced
+
+TEST_CASE("capture deduces type names at compile time")
+{
+    static_assert(std::string_view{ reflex::internal::type_name<int>() } == "int");
+    static_assert(std::string_view{ reflex::internal::type_name<deduced::vec2>() } == "deduced::vec2");
+    static_assert(reflex::internal::alias<deduced::vec2>::deduced == reflex::hashed_string{ "deduced::vec2" });
+
+    reflex::context ctx;
+    reflex::capture<deduced::vec2>(ctx).field<&deduced::vec2::x>("x").field<&deduced::vec2::y>("y");
+
+    const auto type = reflex::lookup(ctx, "deduced::vec2");
+    CHECK(std::string{ type.name() } == "deduced::vec2");
+    CHECK(reflex::lookup<deduced::vec2>(ctx).size() == sizeof(deduced::vec2));
+    // uncaptured field types still carry their deduced name, which typed access checks against
+    const deduced::vec2 v{ 1.0f, 2.0f };
+    CHECK((*type.fields().begin()).get<float>(&v) == 1.0f);
+
+    // an explicit name given on first capture wins over the deduced one
+    reflex::capture<deduced::renamed>(ctx, "renamed");
+    reflex::capture<deduced::renamed>(ctx);
+    CHECK(std::string{ reflex::lookup<deduced::renamed>(ctx).name() } == "renamed");
+}
+
+namespace
+{
+template <size_t N>
+struct threaded
+{
+    int value;
+};
+
+struct nesting
+{
+    threaded<3> inner;
+};
+} // namespace
+
+TEST_CASE("types can be captured and looked up from many threads")
+{
+    constexpr size_t thread_count = 8;
+    constexpr size_t per_thread   = 256;
+
+    std::vector<std::string> names;
+    for (size_t i = 0; i < thread_count * per_thread; ++i) names.push_back("threaded_" + std::to_string(i));
+
+    reflex::context ctx;
+    std::atomic<size_t> misses{ 0 };
+    std::vector<std::thread> pool;
+    for (size_t t = 0; t < thread_count; ++t) {
+        pool.emplace_back([&, t] {
+            for (size_t i = t * per_thread; i < (t + 1) * per_thread; ++i) {
+                const reflex::hashed_string hash{ names[i].c_str() };
+                ctx.emplace(hash, reflex::internal::type_descriptor{ { }, i, { } });
+                if (!ctx.contains(hash)) misses.fetch_add(1);
+            }
+            // every thread races to capture the same types first
+            reflex::capture<threaded<0>>(ctx, "threaded_a");
+            reflex::capture<threaded<1>>(ctx);
+            (void)reflex::lookup<threaded<0>>(ctx);
+            (void)reflex::lookup(ctx, "threaded_a");
+        });
+    }
+    for (auto& thread : pool) thread.join();
+
+    CHECK(misses.load() == 0);
+    CHECK(ctx.size() == names.size() + 2);
+    for (size_t i = 0; i < names.size(); ++i) CHECK(ctx.at(reflex::hashed_string{ names[i].c_str() }).size == i);
+    CHECK(std::string{ reflex::lookup<threaded<0>>(ctx).name() } == "threaded_a");
+    CHECK(reflex::lookup<threaded<1>>(ctx).size() == sizeof(threaded<1>));
+}
+
+TEST_CASE("copy plans and field tables stay intact while other threads capture")
+{
+    constexpr size_t captures = 512;
+
+    reflex::context ctx;
+    reflex::capture<threaded<2>>(ctx, "threaded_c").field<&threaded<2>::value>("value");
+    const reflex::type_handle type = reflex::lookup<threaded<2>>(ctx);
+    // the plan of nesting recurses into threaded_d, which gains fields while the readers run
+    reflex::capture<threaded<3>>(ctx, "threaded_d");
+    reflex::capture<nesting>(ctx, "nesting").field<&nesting::inner>("inner");
+    const reflex::type_handle nested = reflex::lookup<nesting>(ctx);
+
+    std::atomic<bool> done{ false };
+    std::atomic<size_t> torn{ 0 };
+    std::vector<std::thread> readers;
+    for (size_t t = 0; t < 2; ++t) {
+        readers.emplace_back([&] {
+            while (!done.load()) {
+                // every capture invalidates the cached plan and table, a rebuild must not touch these
+                const reflex::copy_plan& plan = type.copy_plan();
+                size_t bytes                  = 0;
+                for (const reflex::copy_run& run : plan.runs) bytes += run.size;
+                const reflex::field_table& table = ctx.field_table();
+                size_t rows                      = 0;
+                table.for_each(reflex::field_filter{ }, [&](size_t) { ++rows; });
+                if (bytes != sizeof(int) || rows != table.size()) torn.fetch_add(1);
+                const reflex::copy_plan& outer = nested.copy_plan();
+                if (outer.bytes != outer.runs.size() * sizeof(int)) torn.fetch_add(1);
+            }
+        });
+    }
+    // fields and attributes are captured into other types meanwhile, growing the descriptors the rebuilds read
+    const auto capture_fields = [&]<typename T>(std::type_identity<T>, const char* type_name) {
+        auto reflector = reflex::capture<T>(ctx, type_name);
+        for (size_t i = 0; i < captures; ++i) {
+            const std::string name = std::string{ type_name } + "_" + std::to_string(i);
+            reflector.template field<&T::value>(name.c_str()).decorate("index", static_cast<int>(i));
+        }
+    };
+    std::thread first{ [&] { capture_fields(std::type_identity<threaded<3>>{ }, "threaded_d"); } };
+    std::thread second{ [&] { capture_fields(std::type_identity<threaded<4>>{ }, "threaded_e"); } };
+    first.join();
+    second.join();
+    done.store(true);
+    for (auto& reader : readers) reader.join();
+
+    CHECK(torn.load() == 0);
+    CHECK(type.copy_plan().bytes == sizeof(int));
+    CHECK(ctx.field_table().size() == 2 + 2 * captures);
+    CHECK(nested.copy_plan().bytes == captures * sizeof(int));
+}
+
+namespace
+{
+struct reloaded
+{
+    int a;
+    float b;
+};
+
+auto count_fields(const reflex::type_handle& type) -> size_t
+{
+    size_t count = 0;
+    for (const auto& field : type.fields()) count += field.size() != 0;
+    return count;
+}
+} // namespace
+
+TEST_CASE("versioned contexts hot reload types while pinned handles keep their version")
+{
+    auto& domain = reflex::internal::epoch_domain::instance();
+
+    reflex::versioned_context types;
+    types.define(reflex::hashed_string{ "reloaded" }, [](reflex::context& ctx) {
+        reflex::capture<reloaded>(ctx, "reloaded").field<&reloaded::a>("a");
+    });
+    CHECK(types.version() == 2);
+
+    {
+        const reflex::type_handle old_type = reflex::lookup<reloaded>(types.pin());
+
+        types.define(reflex::hashed_string{ "reloaded" }, [](reflex::context& ctx) {
+            reflex::capture<reloaded>(ctx, "reloaded").field<&reloaded::a>("a").field<&reloaded::b>("b");
+        });
+
+        // the handle still sees the version it was obtained from, which has not been destroyed
+        CHECK(count_fields(old_type) == 1);
+        CHECK(std::string{ (*old_type.fields().begin()).name() } == "a");
+        CHECK(domain.pending() > 0);
+
+        const auto new_type = reflex::lookup(types.pin(), "reloaded");
+        CHECK(count_fields(new_type) == 2);
+        CHECK(new_type.copy_plan().bytes == sizeof(int) + sizeof(float));
+    }
+
+    // nothing is pinned anymore, every replaced version can go
+    domain.reclaim();
+    CHECK(domain.pending() == 0);
+
+    CHECK_THROWS_AS(types.define(reflex::hashed_string{ "broken" }, [](reflex::context&) { throw reflex::reflection_error{ }; }),
+                    reflex::reflection_error);
+    CHECK(types.version() == 3);
+    CHECK_THROWS_AS(reflex::lookup(types.pin(), "broken"), reflex::reflection_error);
+}
+
+namespace
+{
+/// @brief Constructed during static initialization, before any test has touched the epoch domain.
+reflex::versioned_context static_types;
+} // namespace
+
+TEST_CASE("versioned contexts with static storage duration retire their last version after main")
+{
+    static_types.define(reflex::hashed_string{ "reloaded" }, [](reflex::context& ctx) {
+        reflex::capture<reloaded>(ctx, "reloaded").field<&reloaded::a>("a");
+    });
+    CHECK(reflex::lookup(static_types.pin(), "reloaded").fields().size() == 1);
+    // destroying static_types at exit retires its current version, the epoch domain has to outlive it
+}
+
+namespace
+{
+struct arena_backed
+{
+    int a;
+    int b;
+    int c;
+};
+} // namespace
+
+TEST_CASE("descriptors, fields and names are bump allocated from the context arena")
+{
+    constexpr size_t type_count = 500;
+
+    reflex::context ctx;
+    CHECK(ctx.stats().allocations == 0);
+
+    for (size_t i = 0; i < type_count; ++i) {
+        // the names are destroyed right after capturing, the context keeps its own copies
+        const std::string type_name = "arena_type_" + std::to_string(i);
+        const reflex::hashed_string hash{ type_name.c_str() };
+        ctx.emplace(hash, reflex::internal::type_descriptor{ { }, i, { } });
+    }
+    reflex::capture<arena_backed>(ctx, std::string{ "arena_backed" }.c_str())
+            .field<&arena_backed::a>(std::string{ "a" }.c_str())
+            .field<&arena_backed::b>("b")
+            .field<&arena_backed::c>("c");
+
+    CHECK(std::string{ ctx.at(reflex::hashed_string{ "arena_type_42" }).hash.data() } == "arena_type_42");
+    CHECK(std::string{ reflex::lookup<arena_backed>(ctx).name() } == "arena_backed");
+    CHECK(std::string{ (*reflex::lookup<arena_backed>(ctx).fields().begin()).name() } == "a");
+
+    const reflex::context_stats stats = ctx.stats();
+    CHECK(stats.allocations >= type_count);
+    CHECK(stats.names >= type_count);
+    CHECK(stats.bytes <= stats.bytes_reserved);
+    // thousands of small allocations are served by a handful of chunks
+    CHECK(stats.chunks * 50 < stats.allocations);
+
+    ctx.freeze();
+    CHECK(std::string{ reflex::lookup<arena_backed>(ctx).name() } == "arena_backed");
+    CHECK(ctx.at(reflex::hashed_string{ "arena_type_7" }).size == 7);
+}
+
+namespace
+{
+struct slider
+{
+    float value;
+    float step;
+    int ticks;
+};
+
+struct gauge
+{
+    double level;
+    float limit;
+    float ceiling;
+};
+} // namespace
+
+TEST_CASE("field_table scans every field by type, name and attribute")
+{
+    reflex::context ctx;
+    reflex::capture<slider>(ctx, "slider")
+            .field<&slider::value>("value")
+                .decorate("min", 0.f)
+                .decorate("max", 1.f)
+            .field<&slider::step>("step")
+                .decorate("min", 0.f)
+            .field<&slider::ticks>("ticks")
+                .decorate("max", 10);
+    reflex::capture<gauge>(ctx, "gauge").field<&gauge::level>("level").field<&gauge::limit>("limit");
+
+    const reflex::field_table& table = ctx.field_table();
+    CHECK(table.size() == 5);
+    CHECK(table.count(reflex::field_filter{ }.of_type<float>()) == 3);
+    CHECK(table.count(reflex::field_filter{ }.with_attribute(reflex::hashed_string{ "max" })) == 2);
+    CHECK(table.count(reflex::field_filter{ }.with_attribute(reflex::hashed_string{ "unknown" })) == 0);
+
+    const auto floats_with_max = reflex::find_fields(
+            ctx, reflex::field_filter{ }.of_type<float>().with_attribute(reflex::hashed_string{ "max" }));
+    REQUIRE(floats_with_max.size() == 1);
+    CHECK(std::string{ floats_with_max.front().name() } == "value");
+    CHECK(floats_with_max.front().attribute<float>("max") == 1.f);
+
+    table.for_each(reflex::field_filter{ }.named(reflex::hashed_string{ "limit" }), [&](const size_t row) {
+        CHECK(std::string{ table.owner(row)->hash.data() } == "gauge");
+        CHECK(table.offsets()[row] == offsetof(gauge, limit));
+    });
+
+    // fields captured later invalidate the mirror
+    reflex::capture<gauge>(ctx, "gauge").field<&gauge::ceiling>("ceiling").decorate("max", 2.f);
+    CHECK(ctx.field_table().count(reflex::field_filter{ }.with_attribute(reflex::hashed_string{ "max" })) == 3);
+
+    ctx.freeze();
+    CHECK(ctx.field_table().count(reflex::field_filter{ }.of_type<float>()) == 4);
+}
+
+TEST_CASE("field_table survives moving a frozen context")
+{
+    reflex::context ctx;
+    reflex::capture<gauge>(ctx, "gauge").field<&gauge::level>("level").field<&gauge::limit>("limit");
+    ctx.freeze();
+
+    const reflex::context moved{ std::move(ctx) };
+    CHECK(moved.field_table().size() == 2);
+    CHECK(reflex::find_fields(moved, reflex::field_filter{ }.of_type<float>()).size() == 1);
+
+    // every version of a versioned_context is frozen, then moved into place
+    reflex::versioned_context types;
+    types.define(reflex::hashed_string{ "gauge" }, [](reflex::context& next) {
+        reflex::capture<gauge>(next, "gauge").field<&gauge::level>("level").field<&gauge::limit>("limit");
+    });
+    const reflex::snapshot snap = types.pin();
+    CHECK(reflex::lookup<gauge>(snap).fields().size() == 2);
+    CHECK(reflex::find_fields(snap.get(), reflex::field_filter{ }).size() == 2);
+}
+
+TEST_CASE("fields are found by name through the per-type index")
+{
+    reflex::context ctx;
+    reflex::capture<slider>(ctx, "slider")
+            .field<&slider::value>("value")
+            .field<&slider::step>("step")
+            .field<&slider::ticks>("ticks");
+
+    const reflex::type_handle type = reflex::lookup<slider>(ctx);
+    CHECK(type.field("step").offset() == offsetof(slider, step));
+    CHECK(type.field(reflex::hashed_string{ "ticks" }).offset() == offsetof(slider, ticks));
+    CHECK(type.find_field(reflex::hashed_string{ "value" }).has_value());
+    CHECK_FALSE(type.find_field(reflex::hashed_string{ "missing" }).has_value());
+    CHECK_THROWS_AS(type.field("missing"), reflex::reflection_error);
+
+    // large types switch over to hashing, every field must stay reachable
+    reflex::internal::arena storage;
+    reflex::internal::field_index index;
+    std::vector<std::string> names;
+    for (uint32_t i = 0; i < 100; ++i) names.push_back("field_" + std::to_string(i));
+    for (uint32_t i = 0; i < 100; ++i) CHECK(index.insert(storage, reflex::hashed_string{ names[i].c_str() }.value(), i));
+    CHECK_FALSE(index.insert(storage, reflex::hashed_string{ "field_3" }.value(), 100));
+    CHECK(index.hashed());
+    for (uint32_t i = 0; i < 100; ++i) CHECK(index.find(reflex::hashed_string{ names[i].c_str() }.value()) == i);
+    CHECK(index.find(reflex::hashed_string{ "field_100" }.value()) == reflex::internal::field_index::npos);
+
+    ctx.freeze();
+    CHECK(reflex::lookup<slider>(ctx).field("value").offset() == offsetof(slider, value));
+}
+
+namespace
+{
+struct position
+{
+    float x;
+    float y;
+};
+
+struct transform
+{
+    int parent;
+    position local;
+    position world;
+};
+
+struct entity
+{
+    uint64_t id;
+    transform xform;
+};
+} // namespace
+
+TEST_CASE("paths collapse nested fields into a single offset")
+{
+    reflex::context ctx;
+    reflex::capture<position>(ctx, "position").field<&position::x>("x").field<&position::y>("y");
+    reflex::capture<transform>(ctx, "transform")
+            .field<&transform::parent>("parent")
+            .field<&transform::local>("local")
+            .field<&transform::world>("world");
+    reflex::capture<entity>(ctx, "entity").field<&entity::id>("id").field<&entity::xform>("transform");
+
+    const reflex::path y{ reflex::lookup<entity>(ctx), "transform.world.y" };
+    CHECK(y.offset() == offsetof(entity, xform) + offsetof(transform, world) + offsetof(position, y));
+    CHECK(y.size() == sizeof(float));
+
+    entity e{ };
+    const reflex::path copy = y;
+    copy.set(&e, 2.5f);
+    CHECK(e.xform.world.y == 2.5f);
+    CHECK(y.get<float>(&e) == 2.5f);
+
+    const reflex::path local{ reflex::lookup<entity>(ctx), "transform.local" };
+    CHECK(local.get<position>(&e).x == 0.f);
+
+    CHECK_THROWS_AS(reflex::path(reflex::lookup<entity>(ctx), "transform.missing"), reflex::reflection_error);
+    CHECK_THROWS_AS(reflex::path(reflex::lookup<entity>(ctx), "transform..x"), reflex::reflection_error);
+    // the id is a uint64_t which has no fields to descend into
+    CHECK_THROWS_AS(reflex::path(reflex::lookup<entity>(ctx), "id.x"), reflex::reflection_error);
+#ifndef NDEBUG
+    CHECK_THROWS_AS((void)y.get<double>(&e), reflex::reflection_error);
+#endif
+}
+
+namespace
+{
+struct turret
+{
+    int ammo = 3;
+    std::string label;
+
+    auto fire(const int shots, const float spread) -> float
+    {
+        ammo -= shots;
+        return spread * static_cast<float>(shots);
+    }
+
+    auto remaining() const noexcept -> int { return ammo; }
+
+    auto rename(std::string&& name) -> void { label = std::move(name); }
+
+    auto tag() const -> std::string { return label + "!"; }
+};
+} // namespace
+
+TEST_CASE("methods are invoked through type erased trampolines")
+{
+    reflex::context ctx;
+    reflex::capture<turret>(ctx, "turret")
+            .method<&turret::fire>("fire")
+            .method<&turret::remaining>("remaining")
+            .method<&turret::rename>("rename")
+            .method<&turret::tag>("tag");
+
+    const reflex::type_handle type = reflex::lookup<turret>(ctx);
+    const reflex::method_handle fire = type.method("fire");
+    CHECK(fire.arity() == 2);
+    CHECK(fire.argument_hashes()[0] == reflex::internal::alias<int>::hash());
+    CHECK(fire.return_hash() == reflex::internal::alias<float>::hash());
+    CHECK_FALSE(fire.is_const());
+    CHECK(type.method("remaining").is_const());
+
+    turret t;
+    CHECK(fire.call<float>(&t, 2, 0.5f) == 1.f);
+    CHECK(t.ammo == 1);
+
+    // the raw interface takes argument addresses from a caller supplied buffer
+    int shots      = 1;
+    float spread   = 2.f;
+    void* args[]   = { &shots, &spread };
+    float returned = 0.f;
+    fire.invoke(&t, args, &returned);
+    CHECK(returned == 2.f);
+    CHECK(type.method("remaining").call<int>(&t) == 0);
+
+    std::string name = "north";
+    type.method("rename").call(&t, std::move(name));
+    CHECK(type.method("tag").call<std::string>(&t) == "north!");
+
+    size_t count = 0;
+    for (const reflex::method_handle method : type.methods()) count += method.name() != nullptr;
+    CHECK(count == 4);
+    CHECK_FALSE(type.find_method(reflex::hashed_string{ "reload" }).has_value());
+    CHECK_THROWS_AS(type.method("reload"), reflex::reflection_error);
+#ifndef NDEBUG
+    CHECK_THROWS_AS(fire.call<float>(&t, 2.0, 0.5f), reflex::reflection_error);
+    CHECK_THROWS_AS(fire.call<int>(&t, 2, 0.5f), reflex::reflection_error);
+#endif
+}
+
+namespace
+{
+struct labelled
+{
+    std::string label;
+    int uses = 0;
+
+    auto name() const -> const std::string& { return label; }
+    auto counter() & -> int& { return uses; }
+    auto take() && -> std::string { return std::move(label); }
+};
+} // namespace
+
+TEST_CASE("methods returning references or qualified by reference are invoked")
+{
+    reflex::context ctx;
+    reflex::capture<labelled>(ctx, "labelled")
+            .method<&labelled::name>("name")
+            .method<&labelled::counter>("counter")
+            .method<&labelled::take>("take");
+
+    const reflex::type_handle type = reflex::lookup<labelled>(ctx);
+    labelled l{ "lamp" };
+    CHECK(type.method("name").is_const());
+    const std::string& name = type.method("name").call<const std::string&>(&l);
+    CHECK(&name == &l.label);
+
+    type.method("counter").call<int&>(&l) = 3;
+    CHECK(l.uses == 3);
+
+    // && qualified methods are called on the object as an rvalue
+    CHECK(type.method("take").call<std::string>(&l) == "lamp");
+    CHECK(l.label.empty());
+
+    static_assert(reflex::method_info<int (labelled::*)() const volatile & noexcept>::is_const);
+    static_assert(!reflex::method_info<int (labelled::*)() volatile>::is_const);
+    static_assert(reflex::method_info<int (labelled::*)() const && noexcept>::is_rvalue);
+}
+
+namespace
+{
+struct named_node
+{
+    int id;
+};
+
+struct scaled
+{
+    double scale;
+};
+
+struct body : named_node
+{
+    float mass;
+};
+
+// the scaled subobject sits behind body, so its fields are shifted
+struct rigid_body : body, scaled
+{
+    float drag;
+};
+} // namespace
+
+TEST_CASE("base classes flatten their fields into the derived type")
+{
+    reflex::context ctx;
+    reflex::capture<named_node>(ctx, "named_node").field<&named_node::id>("id").decorate("min", 1);
+    reflex::capture<scaled>(ctx, "scaled").field<&scaled::scale>("scale");
+    reflex::capture<body>(ctx, "body").base<named_node>().field<&body::mass>("mass");
+    reflex::capture<rigid_body>(ctx, "rigid_body").base<body>().base<scaled>().field<&rigid_body::drag>("drag");
+
+    const reflex::type_handle type = reflex::lookup<rigid_body>(ctx);
+    size_t count = 0;
+    for (const reflex::field_handle field : type.fields()) count += field.size() != 0;
+    CHECK(count == 4);
+
+    rigid_body obj{ };
+    obj.id    = 7;
+    obj.scale = 2.5;
+    CHECK(type.field("id").get<int>(&obj) == 7);
+    CHECK(type.field("scale").get<double>(&obj) == 2.5);
+    CHECK(type.field("scale").offset() ==
+          static_cast<size_t>(reinterpret_cast<const std::byte*>(static_cast<const scaled*>(&obj)) -
+                              reinterpret_cast<const std::byte*>(&obj)));
+    CHECK(type.field("id").attribute<int>("min") == 1);
+
+    CHECK(type.is_a<rigid_body>());
+    CHECK(type.is_a<body>());
+    CHECK(type.is_a<named_node>());
+    CHECK(type.is_a(reflex::lookup<scaled>(ctx)));
+    CHECK_FALSE(reflex::lookup<body>(ctx).is_a<scaled>());
+
+    // inherited fields take part in everything built from the field list
+    CHECK(type.copy_plan().bytes == sizeof(int) + sizeof(float) + sizeof(double) + sizeof(float));
+
+    // bases must be captured into the same context first
+    reflex::context other;
+    CHECK_THROWS_AS(reflex::capture<body>(other, "body").base<named_node>(), reflex::reflection_error);
+}
+
+namespace
+{
+enum class channel
+{
+    red,
+    green,
+    blue,
+    alpha,
+};
+
+enum class access_flags : uint32_t
+{
+    read    = 1u << 0,
+    write   = 1u << 8,
+    execute = 1u << 31,
+};
+} // namespace
+
+TEST_CASE("captured enums convert between names and values")
+{
+    reflex::context ctx;
+    reflex::capture_enum<channel>(ctx).values<channel::red, channel::green, channel::blue>().value(channel::alpha, "A");
+
+    CHECK(std::string{ reflex::enum_name(ctx, channel::green) } == "green");
+    CHECK(std::string{ reflex::enum_name(ctx, channel::alpha) } == "A");
+    CHECK(reflex::enum_name(ctx, static_cast<channel>(42)) == nullptr);
+    CHECK(reflex::enum_value<channel>(ctx, "blue") == channel::blue);
+    CHECK(reflex::enum_value<channel>(ctx, std::string_view{ "red, green" }.substr(0, 3)) == channel::red);
+    CHECK_FALSE(reflex::enum_value<channel>(ctx, "purple").has_value());
+    CHECK(std::string{ reflex::lookup<channel>(ctx).name() }.ends_with("channel"));
+
+    // values spread over a wide range are searched instead of indexed densely
+    reflex::capture_enum<access_flags>(ctx, "access_flags")
+            .values<access_flags::read, access_flags::write, access_flags::execute>();
+    CHECK(std::string{ reflex::enum_name(ctx, access_flags::execute) } == "execute");
+    CHECK(reflex::enum_value<access_flags>(ctx, "write") == access_flags::write);
+    CHECK(reflex::enum_name(ctx, static_cast<access_flags>(3)) == nullptr);
+
+    ctx.freeze();
+    CHECK(reflex::enum_value<channel>(ctx, "A") == channel::alpha);
+    CHECK_THROWS_AS(reflex::enum_name(ctx, reflex::internal::value_name_probe::probe), reflex::reflection_error);
+}
+
+namespace
+{
+struct tuning
+{
+    static float gravity;
+    static inline int iterations = 4;
+    float local;
+};
+
+float tuning::gravity = 9.81f;
+
+struct tuned_body : tuning
+{
+    float mass;
+};
+} // namespace
+
+TEST_CASE("static fields are accessed through their address without an instance")
+{
+    reflex::context ctx;
+    reflex::capture<tuning>(ctx, "tuning")
+            .field<&tuning::gravity>("gravity")
+                .decorate("min", 0.f)
+            .field<&tuning::local>("local")
+            .field<&tuning::iterations>("iterations");
+
+    const reflex::type_handle type = reflex::lookup<tuning>(ctx);
+    CHECK(type.fields().size() == 1);
+    CHECK(type.statics().size() == 2);
+    CHECK(type.copy_plan().bytes == sizeof(float));
+
+    const reflex::field_handle gravity = type.field("gravity");
+    CHECK(gravity.is_static());
+    CHECK_FALSE(type.field("local").is_static());
+    CHECK(gravity.get<float>() == 9.81f);
+    CHECK(gravity.attribute<float>("min") == 0.f);
+
+    gravity.set(1.62f);
+    CHECK(tuning::gravity == 1.62f);
+    type.field("iterations").ref<int>() = 8;
+    CHECK(tuning::iterations == 8);
+
+    // statics are inherited along with the member fields
+    reflex::capture<tuned_body>(ctx, "tuned_body").base<tuning>().field<&tuned_body::mass>("mass");
+    CHECK(reflex::lookup<tuned_body>(ctx).field("gravity").get<float>() == 1.62f);
+    CHECK(reflex::lookup<tuned_body>(ctx).statics().size() == 2);
+    CHECK_THROWS_AS(reflex::path(type, "gravity"), reflex::reflection_error);
+
+#ifndef NDEBUG
+    tuning obj{ };
+    CHECK_THROWS_AS((void)gravity.get<float>(&obj), reflex::reflection_error);
+    CHECK_THROWS_AS((void)type.field("local").get<float>(), reflex::reflection_error);
+#endif
+}
+
+namespace
+{
+struct shadowed
+{
+    int id;
+    float weight;
+};
+
+struct shadowing : shadowed
+{
+    int id;
+};
+} // namespace
+
+TEST_CASE("fields of a type shadow the inherited fields of the same name")
+{
+    reflex::context ctx;
+    reflex::capture<shadowed>(ctx, "shadowed").field<&shadowed::id>("id").field<&shadowed::weight>("weight");
+    reflex::capture<shadowing>(ctx, "shadowing").field<&shadowing::id>("id").base<shadowed>();
+
+    const reflex::type_handle type = reflex::lookup<shadowing>(ctx);
+    CHECK(type.fields().size() == 2);
+    shadowing obj{ };
+    obj.shadowed::id = 1;
+    obj.id           = 2;
+    obj.weight       = 0.5f;
+    CHECK(type.field("id").get<int>(&obj) == 2);
+    CHECK(type.field("weight").get<float>(&obj) == 0.5f);
+    CHECK(type.copy_plan().bytes == sizeof(int) + sizeof(float));
+}
+
+TEST_CASE("hashed string literals key lookups without runtime hashing")
+{
+    using namespace reflex::literals;
+    static_assert("min"_hs == reflex::hashed_string{ "min" });
+    static_assert(("decorated"_hs).length() == 9);
+
+    reflex::context ctx;
+    reflex::capture<decorated>(ctx, "decorated").field<&decorated::value>("value").decorate("min", 1.f);
+
+    const reflex::type_handle type = reflex::lookup(ctx, "decorated"_hs);
+    CHECK(std::string{ type.name() } == "decorated");
+    CHECK_THROWS_AS(reflex::lookup(ctx, "undecorated"_hs), reflex::reflection_error);
+
+    const reflex::field_handle field = type.field("value"_hs);
+    CHECK(field.attribute<float>("min"_hs) == 1.f);
+    CHECK(field.has_attribute("min"_hs));
+    CHECK(field.find_attribute<float>("max"_hs) == nullptr);
+    CHECK(type.find_field("value"_hs).has_value());
+}
+
+namespace
+{
+/// @brief Hashes every prefix of text at compile time, so the runtime reads can be checked against it.
+template <typename Hasher, size_t N>
+constexpr auto constant_hashes(const char (&text)[N])
+{
+    std::array<uint64_t, N> hashes{ };
+    for (size_t i = 0; i < N; ++i) hashes[i] = Hasher::hash(text, i);
+    return hashes;
+}
+
+constexpr char hash_text[] = "reflex::internal::flat_table<reflex::internal::type_descriptor*, std::allocator<char>>";
+} // namespace
+
+TEST_CASE("hash policies agree between compile time and runtime")
+{
+    static_assert(reflex::fnv1a::hash("a", 1) == 0xaf63dc4c8601ec8cull);
+    static_assert(reflex::basic_hashed_string<reflex::fnv1a>{ "a" }.value() == 0xaf63dc4c8601ec8cull);
+    static_assert(std::is_same_v<reflex::hashed_string::hasher, reflex::default_hasher>);
+
+    constexpr auto wy  = constant_hashes<reflex::wyhash>(hash_text);
+    constexpr auto fnv = constant_hashes<reflex::fnv1a>(hash_text);
+    // a copy the compiler can not see through, so the word reads take their runtime path
+    const std::string text{ hash_text };
+    for (size_t i = 0; i < wy.size(); ++i) {
+        CHECK(reflex::wyhash::hash(text.data(), i) == wy[i]);
+        CHECK(reflex::fnv1a::hash(text.data(), i) == fnv[i]);
+    }
+
+    // every prefix length, including the 4, 16 and 48 byte boundaries, hashes differently
+    std::vector<uint64_t> sorted(wy.begin(), wy.end());
+    std::ranges::sort(sorted);
+    CHECK(std::ranges::adjacent_find(sorted) == sorted.end());
+    CHECK(reflex::wyhash::hash("ab", 2) != reflex::wyhash::hash("ba", 2));
+}
+
+TEST_CASE("types whose names collide on the hash stay apart")
+{
+    // a genuine 64-bit collision is impractical to find, so forge one with the hash of another name
+    const reflex::hashed_string first{ "collider_a" };
+    const reflex::hashed_string second = reflex::internal::forged_hash(first.value(), "collider_b");
+    REQUIRE(first == second);
+    REQUIRE_FALSE(first.same_string(second));
+
+    reflex::context ctx;
+    auto [a, a_inserted] = ctx.emplace(first, reflex::internal::type_descriptor{ { }, 4, { } });
+    auto [b, b_inserted] = ctx.emplace(second, reflex::internal::type_descriptor{ { }, 8, { } });
+    CHECK(a_inserted);
+    CHECK(b_inserted);
+    CHECK(a != b);
+    CHECK(ctx.emplace(second, reflex::internal::type_descriptor{ { }, 16, { } }).first == b);
+    CHECK(ctx.size() == 2);
+    CHECK(ctx.find(first)->size == 4);
+    CHECK(ctx.find(second)->size == 8);
+    CHECK(ctx.find(reflex::internal::forged_hash(first.value(), "collider_c")) == nullptr);
+
+    ctx.freeze();
+    CHECK(ctx.size() == 2);
+    CHECK(ctx.find(first)->size == 4);
+    CHECK(ctx.find(second)->size == 8);
+    CHECK(std::string{ ctx.find(second)->hash.data() } == "collider_b");
+    CHECK(ctx.find(reflex::internal::forged_hash(first.value(), "collider_c")) == nullptr);
+}
+
+namespace
+{
+struct interned_a
+{
+    int x;
+    float y;
+};
+
+struct interned_b
+{
+    int x;
+};
+} // namespace
+
+TEST_CASE("names are interned once per context and outlive the strings they were built from")
+{
+    CHECK(sizeof(reflex::interned_string) < sizeof(reflex::hashed_string));
+
+    reflex::context ctx;
+    reflex::capture<interned_a>(ctx, std::string{ "interned_a" }.c_str())
+            .field<&interned_a::x>(std::string{ "x" }.c_str())
+            .field<&interned_a::y>(std::string{ "y" }.c_str());
+    const size_t names = ctx.stats().names;
+
+    // only the type name is new, "x" and "int" are shared with interned_a
+    reflex::capture<interned_b>(ctx, "interned_b").field<&interned_b::x>("x");
+    CHECK(ctx.stats().names == names + 1);
+
+    const auto a_x = reflex::lookup<interned_a>(ctx).field("x");
+    const auto b_x = reflex::lookup<interned_b>(ctx).field("x");
+    CHECK(a_x.name() == b_x.name());
+    CHECK(a_x.type_hash().data() == b_x.type_hash().data());
+    CHECK(std::string{ a_x.type_hash().data() } == "int");
+    CHECK(a_x.type_hash().length() == 3);
+
+    // the name given on first capture is kept for T, every later context captures it under a copy
+    reflex::context other;
+    reflex::capture<interned_a>(other, std::string{ "ignored" }.c_str()).field<&interned_a::y>("y");
+    CHECK(std::string{ reflex::lookup<interned_a>(other).name() } == "interned_a");
+    CHECK(reflex::lookup<interned_a>(other).name() != reflex::lookup<interned_a>(ctx).name());
+    CHECK(reflex::lookup(other, "interned_a").field("y").type_hash() == reflex::internal::alias<float>::hash());
+}
+
+namespace
+{
+struct batched
+{
+    int a;
+    float b;
+    double c;
+    char d;
+    short e;
+};
+} // namespace
+
+static_assert(std::random_access_iterator<reflex::field_range::iterator>);
+// handles are made on dereference, so legacy algorithms only get to read and nothing can be written through it
+static_assert(std::is_same_v<
+              std::iterator_traits<reflex::field_range::iterator>::iterator_category,
+              std::input_iterator_tag>);
+static_assert(!std::indirectly_writable<reflex::field_range::iterator, reflex::field_handle>);
+static_assert(std::ranges::random_access_range<reflex::field_range>);
+static_assert(std::ranges::sized_range<reflex::method_range>);
+static_assert(std::ranges::view<reflex::field_range>);
+static_assert(std::ranges::borrowed_range<reflex::field_range>);
+
+TEST_CASE("field ranges are sized random access views")
+{
+    reflex::context ctx;
+    reflex::capture<batched>(ctx, "batched")
+            .field<&batched::a>("a")
+            .field<&batched::b>("b")
+            .field<&batched::c>("c")
+            .field<&batched::d>("d")
+            .field<&batched::e>("e");
+
+    const reflex::field_range fields = reflex::lookup<batched>(ctx).fields();
+    REQUIRE(fields.size() == 5);
+    CHECK_FALSE(fields.empty());
+    CHECK(fields.end() - fields.begin() == 5);
+    CHECK(std::string{ fields[2].name() } == "c");
+    CHECK(std::string{ fields.back().name() } == "e");
+    CHECK(std::string{ (fields.begin() + 3)[1].name() } == "e");
+    CHECK(std::string{ (2 + fields.begin())->name() } == "c");
+    CHECK(fields.begin() < fields.end());
+    CHECK(fields.end() - 1 > fields.begin() + 3);
+    CHECK(fields.data()[1].offset == offsetof(batched, b));
+
+    // the iterator outlives the range it came from
+    const auto found = std::ranges::find_if(reflex::lookup<batched>(ctx).fields(), [](const reflex::field_handle f) {
+        return f.size() == sizeof(double);
+    });
+    CHECK(std::string{ (*found).name() } == "c");
+
+    // slices for batched work
+    std::vector<std::string> second_batch;
+    for (const reflex::field_handle field : fields | std::views::drop(2) | std::views::take(2)) {
+        second_batch.emplace_back(field.name());
+    }
+    CHECK(second_batch == std::vector<std::string>{ "c", "d" });
+    CHECK(std::ranges::distance(std::views::counted(fields.begin() + 4, 1)) == 1);
+
+    const size_t bytes = std::accumulate(fields.begin(), fields.end(), size_t{ 0 }, [](const size_t sum, const auto f) {
+        return sum + f.size();
+    });
+    CHECK(bytes == sizeof(int) + sizeof(float) + sizeof(double) + sizeof(char) + sizeof(short));
+}